@@ -0,0 +1,126 @@
+/* Host JVM benchmark of the JNI call overhead of io.liteglue.SQLiteNative (make bench-jni),
+ * run against a host build of the native library with the native methods registered in JNI_OnLoad()
+ * & against one built with -DSQLC_JNI_NO_REGISTER (native methods looked up by name on the first call).
+ *
+ * usage: java -cp bench/jni SQLiteNativeBench LIBRARY [--rows=N] [--rounds=N]
+ *   LIBRARY       path of the native library (System.load())
+ *   --rows=N      rows of the table read in each round (default 100000)
+ *   --rounds=N    rounds of reading all rows (default 20, the first half is warm-up)
+ *
+ * Prints one JSON report to stdout: time to load the library, time of the first call of some
+ * native methods (includes the symbol lookup unless registered) & the median ns per call of
+ * sqlc_api_version_check(), sqlc_st_step() & sqlc_st_column_long() after warm-up. */
+
+import io.liteglue.SQLiteNative;
+
+import java.util.Arrays;
+
+public class SQLiteNativeBench {
+
+  static long firstCallNs(Runnable r) {
+    long t0 = System.nanoTime();
+    r.run();
+    return System.nanoTime() - t0;
+  }
+
+  static long median(long[] v, int from) {
+    long[] w = Arrays.copyOfRange(v, from, v.length);
+    Arrays.sort(w);
+    return w[w.length / 2];
+  }
+
+  static void check(boolean ok, String what) {
+    if (!ok) {
+      System.err.println("failed: " + what);
+      System.exit(1);
+    }
+  }
+
+  public static void main(String[] args) {
+    String lib = null;
+    int rows = 100000;
+    int rounds = 20;
+    boolean bad = false;
+
+    for (String a : args) {
+      if (a.startsWith("--rows=")) rows = Integer.parseInt(a.substring(7));
+      else if (a.startsWith("--rounds=")) rounds = Integer.parseInt(a.substring(9));
+      else if (!a.startsWith("--") && lib == null) lib = a;
+      else bad = true;
+    }
+    if (bad || lib == null || rows < 1 || rounds < 2) {
+      System.err.println("bad option, see the usage in bench/SQLiteNativeBench.java");
+      System.exit(2);
+    }
+
+    long t0 = System.nanoTime();
+    System.load(new java.io.File(lib).getAbsolutePath());
+    long loadNs = System.nanoTime() - t0;
+
+    // first calls (each method is linked on its first call unless registered in JNI_OnLoad):
+    final long[] h = new long[2];
+    long fcVersion = firstCallNs(() -> check(SQLiteNative.sqlc_api_version_check(SQLiteNative.SQLC_API_VERSION) == 0, "version"));
+    long fcOpen = firstCallNs(() -> h[0] = SQLiteNative.sqlc_db_open(":memory:",
+      SQLiteNative.SQLC_OPEN_READWRITE | SQLiteNative.SQLC_OPEN_CREATE));
+    check(h[0] > 0, "open");
+    long fcPrepare = firstCallNs(() -> h[1] = SQLiteNative.sqlc_db_prepare_st(h[0], "CREATE TABLE t(id INTEGER PRIMARY KEY)"));
+    check(h[1] > 0, "prepare");
+    long fcStep = firstCallNs(() -> check(SQLiteNative.sqlc_st_step(h[1]) == SQLiteNative.SQLC_RESULT_DONE, "create"));
+    long fcFinish = firstCallNs(() -> SQLiteNative.sqlc_st_finish(h[1]));
+
+    long st = SQLiteNative.sqlc_db_prepare_st(h[0],
+      "INSERT INTO t WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x+1 FROM c LIMIT " + rows + ") SELECT x FROM c");
+    check(st > 0 && SQLiteNative.sqlc_st_step(st) == SQLiteNative.SQLC_RESULT_DONE, "insert");
+    SQLiteNative.sqlc_st_finish(st);
+
+    st = SQLiteNative.sqlc_db_prepare_st(h[0], "SELECT id FROM t");
+    check(st > 0 && SQLiteNative.sqlc_st_step(st) == SQLiteNative.SQLC_RESULT_ROW, "select");
+    final long st1 = st;
+    long fcColumn = firstCallNs(() -> SQLiteNative.sqlc_st_column_long(st1, 0));
+    SQLiteNative.sqlc_st_finish(st);
+
+    long[] versionNs = new long[rounds];
+    long[] stepNs = new long[rounds];
+    long[] columnNs = new long[rounds];
+    long sum = 0;
+
+    for (int r = 0; r < rounds; ++r) {
+      int n;
+
+      t0 = System.nanoTime();
+      for (n = 0; n < rows; ++n) sum += SQLiteNative.sqlc_api_version_check(SQLiteNative.SQLC_API_VERSION);
+      versionNs[r] = System.nanoTime() - t0;
+
+      // step only, then step & column (column = difference):
+      st = SQLiteNative.sqlc_db_prepare_st(h[0], "SELECT id FROM t");
+      t0 = System.nanoTime();
+      for (n = 0; SQLiteNative.sqlc_st_step(st) == SQLiteNative.SQLC_RESULT_ROW; ++n)
+        ;
+      stepNs[r] = System.nanoTime() - t0;
+      SQLiteNative.sqlc_st_finish(st);
+      check(n == rows, "rows");
+
+      st = SQLiteNative.sqlc_db_prepare_st(h[0], "SELECT id FROM t");
+      t0 = System.nanoTime();
+      while (SQLiteNative.sqlc_st_step(st) == SQLiteNative.SQLC_RESULT_ROW)
+        sum += SQLiteNative.sqlc_st_column_long(st, 0);
+      columnNs[r] = System.nanoTime() - t0 - stepNs[r];
+      SQLiteNative.sqlc_st_finish(st);
+    }
+
+    check(sum == (long)rows * (rows + 1) / 2 * rounds, "sum");
+    SQLiteNative.sqlc_db_close(h[0]);
+
+    int w = rounds / 2;
+    System.out.println("{");
+    System.out.printf("  \"config\": {\"library\": \"%s\", \"rows\": %d, \"rounds\": %d, \"java\": \"%s\"},%n",
+      lib, rows, rounds, System.getProperty("java.vm.name") + " " + System.getProperty("java.version"));
+    System.out.printf("  \"load_us\": %.1f,%n", loadNs / 1e3);
+    System.out.printf("  \"first_call_us\": {\"sqlc_api_version_check\": %.1f, \"sqlc_db_open\": %.1f, \"sqlc_db_prepare_st\": %.1f, "
+      + "\"sqlc_st_step\": %.1f, \"sqlc_st_finish\": %.1f, \"sqlc_st_column_long\": %.1f},%n",
+      fcVersion / 1e3, fcOpen / 1e3, fcPrepare / 1e3, fcStep / 1e3, fcFinish / 1e3, fcColumn / 1e3);
+    System.out.printf("  \"ns_per_call\": {\"sqlc_api_version_check\": %.1f, \"sqlc_st_step\": %.1f, \"sqlc_st_column_long\": %.1f}%n",
+      (double)median(versionNs, w) / rows, (double)median(stepNs, w) / rows, (double)median(columnNs, w) / rows);
+    System.out.println("}");
+  }
+}
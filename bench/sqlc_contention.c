@@ -0,0 +1,376 @@
+/* Host benchmark: reader & writer threads on connections to one database file,
+ * built with the same threading options as the Android library (make bench).
+ *
+ * usage: sqlc_contention [--key=value ...]
+ *   --db=PATH                  database file (default /tmp/sqlc_contention.db, recreated)
+ *   --readers=N --writers=N    threads (default 4 & 1)
+ *   --journal=wal|delete       journal mode (default wal)
+ *   --mutex=nomutex|fullmutex  open flag (default nomutex)
+ *   --connections=thread|shared  one connection per thread or one shared connection
+ *                              (shared needs --mutex=fullmutex & --write-batch=1)
+ *   --seconds=S --rows=N --busy-timeout=MS --write-batch=N
+ *
+ * Prints one JSON report to stdout: throughput, latency percentiles & SQLITE_BUSY results
+ * of the reads & writes, lock conflicts & time waiting in the busy handler
+ * (sqlc_db_busy_profile_start()) & contended SQLite mutexes with the time waiting for them. */
+
+#include "sqlite3.c"
+
+#include "sqlc.h"
+
+#include "jsmn.c"
+
+#include "sqlc.c"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Latency histogram: exact below 64 ns, else 64 buckets per power of 2 (< 1.6% error):
+#define HIST_SUB 64
+#define HIST_BUCKETS (HIST_SUB * 40)
+
+struct hist {
+  sqlc_long_t count;
+  sqlc_long_t busy; // operations that failed with SQLITE_BUSY
+  sqlc_long_t max_ns;
+  sqlc_long_t b[HIST_BUCKETS];
+};
+
+static int hist_index(sqlc_long_t ns)
+{
+  int e = 0;
+
+  if (ns < HIST_SUB) return ns;
+  while ((ns >> e) >= 2 * HIST_SUB) ++e;
+  if (e >= 39) return HIST_BUCKETS - 1;
+  return (e + 1) * HIST_SUB + (int)((ns >> e) - HIST_SUB);
+}
+
+// lowest ns of a bucket:
+static sqlc_long_t hist_value(int i)
+{
+  int e;
+
+  if (i < HIST_SUB) return i;
+  e = i / HIST_SUB - 1;
+  return (sqlc_long_t)(HIST_SUB + i % HIST_SUB) << e;
+}
+
+static void hist_add(struct hist * h, sqlc_long_t ns)
+{
+  ++h->count;
+  ++h->b[hist_index(ns)];
+  if (ns > h->max_ns) h->max_ns = ns;
+}
+
+static void hist_merge(struct hist * to, const struct hist * from)
+{
+  int i;
+
+  to->count += from->count;
+  to->busy += from->busy;
+  if (from->max_ns > to->max_ns) to->max_ns = from->max_ns;
+  for (i = 0; i < HIST_BUCKETS; ++i) to->b[i] += from->b[i];
+}
+
+static sqlc_long_t hist_percentile(const struct hist * h, double p)
+{
+  sqlc_long_t want = (sqlc_long_t)(h->count * p);
+  sqlc_long_t n = 0;
+  int i;
+
+  for (i = 0; i < HIST_BUCKETS; ++i) {
+    n += h->b[i];
+    if (n > want) return hist_value(i);
+  }
+  return h->max_ns;
+}
+
+// Mutex profiling: time spent in xMutexEnter() when the mutex is held by another thread:
+static sqlite3_mutex_methods orig_mutex;
+static sqlc_long_t mutex_contended;
+static sqlc_long_t mutex_wait_ns;
+
+static void prof_mutex_enter(sqlite3_mutex * m)
+{
+  sqlc_long_t t0;
+
+  if (orig_mutex.xMutexTry(m) == SQLITE_OK) return;
+
+  t0 = sqlc_busy_now_ns();
+  orig_mutex.xMutexEnter(m);
+  __atomic_fetch_add(&mutex_contended, 1, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&mutex_wait_ns, sqlc_busy_now_ns() - t0, __ATOMIC_RELAXED);
+}
+
+static int prof_mutex_install(void)
+{
+  sqlite3_mutex_methods m;
+  int rv;
+
+  // the default methods are only set by sqlite3_initialize() & sqlite3_config() needs a shutdown:
+  rv = sqlite3_initialize();
+  if (rv == SQLITE_OK) rv = sqlite3_shutdown();
+  if (rv == SQLITE_OK) rv = sqlite3_config(SQLITE_CONFIG_GETMUTEX, &orig_mutex);
+  if (rv != SQLITE_OK) return rv;
+
+  m = orig_mutex;
+  m.xMutexEnter = prof_mutex_enter;
+  rv = sqlite3_config(SQLITE_CONFIG_MUTEX, &m);
+  if (rv == SQLITE_OK) rv = sqlite3_initialize();
+  return rv;
+}
+
+struct options {
+  const char * db;
+  int readers;
+  int writers;
+  const char * journal;
+  int fullmutex;
+  int shared;
+  int seconds;
+  int rows;
+  int busy_timeout;
+  int write_batch;
+};
+
+struct worker {
+  pthread_t thread;
+  const struct options * opt;
+  sqlc_handle_t db;
+  int writer;
+  unsigned int seed;
+  int error; // other than SQLITE_BUSY
+  struct hist h;
+};
+
+static int stop_flag;
+
+static int open_flags(const struct options * opt)
+{
+  return SQLC_OPEN_READWRITE | SQLC_OPEN_CREATE | (opt->fullmutex ? SQLC_OPEN_FULLMUTEX : SQLC_OPEN_NOMUTEX);
+}
+
+static int exec_sql(sqlc_handle_t db, const char * sql)
+{
+  return sqlite3_exec(HANDLE_TO_VP(db), sql, NULL, NULL, NULL);
+}
+
+static int setup(const struct options * opt)
+{
+  char sql[200];
+  sqlc_handle_t db;
+  int rv;
+
+  unlink(opt->db);
+  snprintf(sql, sizeof sql, "%s-wal", opt->db);
+  unlink(sql);
+  snprintf(sql, sizeof sql, "%s-shm", opt->db);
+  unlink(sql);
+
+  db = sqlc_db_open(opt->db, open_flags(opt));
+  if (db < 0) return -db;
+
+  snprintf(sql, sizeof sql, "PRAGMA journal_mode=%s", opt->journal);
+  rv = exec_sql(db, sql);
+  if (rv == SQLITE_OK) rv = exec_sql(db, "CREATE TABLE t(id INTEGER PRIMARY KEY, v INTEGER, pad TEXT)");
+  if (rv == SQLITE_OK) {
+    snprintf(sql, sizeof sql,
+      "WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x+1 FROM c LIMIT %d) "
+      "INSERT INTO t SELECT x, 0, hex(randomblob(50)) FROM c", opt->rows);
+    rv = exec_sql(db, sql);
+  }
+
+  sqlc_db_close(db);
+  return rv;
+}
+
+static int step_done(sqlc_handle_t st)
+{
+  int rv;
+
+  while ((rv = sqlc_st_step(st)) == SQLITE_ROW)
+    ;
+  sqlc_st_reset(st);
+  return (rv == SQLITE_DONE) ? SQLITE_OK : rv;
+}
+
+static void * worker_run(void * p)
+{
+  struct worker * w = p;
+  const struct options * opt = w->opt;
+  sqlc_handle_t st = sqlc_db_prepare_st(w->db, w->writer ?
+    "UPDATE t SET v = v + 1 WHERE id = ?" : "SELECT v, pad FROM t WHERE id = ?");
+  sqlc_handle_t begin = 0, commit = 0;
+  int batch = w->writer ? opt->write_batch : 1;
+
+  if (st < 0) {
+    w->error = -st;
+    return NULL;
+  }
+  if (batch > 1) {
+    begin = sqlc_db_prepare_st(w->db, "BEGIN IMMEDIATE");
+    commit = sqlc_db_prepare_st(w->db, "COMMIT");
+  }
+
+  while (!__atomic_load_n(&stop_flag, __ATOMIC_RELAXED)) {
+    sqlc_long_t t0 = sqlc_busy_now_ns();
+    int rv = (begin > 0) ? step_done(begin) : SQLITE_OK;
+    int i;
+
+    for (i = 0; i < batch && rv == SQLITE_OK; ++i) {
+      sqlc_st_bind_int(st, 1, 1 + rand_r(&w->seed) % opt->rows);
+      rv = step_done(st);
+    }
+    if (rv == SQLITE_OK && commit > 0) rv = step_done(commit);
+    if (rv != SQLITE_OK && begin > 0 && !sqlite3_get_autocommit(HANDLE_TO_VP(w->db)))
+      exec_sql(w->db, "ROLLBACK");
+
+    if (rv == SQLITE_OK) {
+      hist_add(&w->h, sqlc_busy_now_ns() - t0);
+    } else if ((rv & 0xff) == SQLITE_BUSY) {
+      ++w->h.busy;
+    } else {
+      w->error = rv;
+      break;
+    }
+  }
+
+  sqlc_st_finish(st);
+  if (begin > 0) sqlc_st_finish(begin);
+  if (commit > 0) sqlc_st_finish(commit);
+  return NULL;
+}
+
+static void print_hist(const char * name, const struct hist * h, double secs)
+{
+  printf("  \"%s\": {\"ops\": %lld, \"ops_per_s\": %.1f, \"p50_us\": %.1f, \"p99_us\": %.1f, "
+    "\"max_us\": %.1f, \"busy\": %lld},\n", name, h->count, h->count / secs,
+    hist_percentile(h, 0.5) / 1e3, hist_percentile(h, 0.99) / 1e3, h->max_ns / 1e3, h->busy);
+}
+
+static int parse_options(int argc, char ** argv, struct options * opt)
+{
+  int i;
+
+  for (i = 1; i < argc; ++i) {
+    const char * a = argv[i];
+    const char * v = strchr(a, '=');
+    size_t kl = (v == NULL) ? strlen(a) : (size_t)(v - a);
+
+    if (v == NULL) return -1;
+    ++v;
+
+#define OPT(k) (kl == strlen(k) && !strncmp(a, k, kl))
+    if (OPT("--db")) opt->db = v;
+    else if (OPT("--readers")) opt->readers = atoi(v);
+    else if (OPT("--writers")) opt->writers = atoi(v);
+    else if (OPT("--journal")) opt->journal = v;
+    else if (OPT("--mutex")) opt->fullmutex = !strcmp(v, "fullmutex");
+    else if (OPT("--connections")) opt->shared = !strcmp(v, "shared");
+    else if (OPT("--seconds")) opt->seconds = atoi(v);
+    else if (OPT("--rows")) opt->rows = atoi(v);
+    else if (OPT("--busy-timeout")) opt->busy_timeout = atoi(v);
+    else if (OPT("--write-batch")) opt->write_batch = atoi(v);
+    else return -1;
+#undef OPT
+  }
+
+  if (opt->readers < 0 || opt->writers < 0 || opt->readers + opt->writers < 1) return -1;
+  if (strcmp(opt->journal, "wal") && strcmp(opt->journal, "delete")) return -1;
+  if (opt->seconds < 1 || opt->rows < 1 || opt->busy_timeout < 0 || opt->write_batch < 1) return -1;
+  // a transaction belongs to the connection, not to the thread:
+  if (opt->shared && (!opt->fullmutex || opt->write_batch > 1)) return -1;
+  return 0;
+}
+
+int main(int argc, char ** argv)
+{
+  struct options opt = { "/tmp/sqlc_contention.db", 4, 1, "wal", 0, 0, 5, 10000, 5000, 1 };
+  struct worker * w;
+  struct hist * rh, * wh;
+  sqlc_handle_t * busy;
+  sqlc_long_t bs[SQLC_BUSY_STAT_COUNT] = { 0 };
+  int nt, nc, i, rv;
+  sqlc_long_t t0;
+  double secs;
+
+  if (parse_options(argc, argv, &opt) != 0) {
+    fprintf(stderr, "bad option, see the usage in bench/sqlc_contention.c\n");
+    return 2;
+  }
+
+  rv = prof_mutex_install();
+  if (rv == SQLITE_OK) rv = setup(&opt);
+  if (rv != SQLITE_OK) {
+    fprintf(stderr, "setup failed: %s\n", sqlite3_errstr(rv));
+    return 1;
+  }
+
+  nt = opt.readers + opt.writers;
+  nc = opt.shared ? 1 : nt;
+  w = calloc(nt, sizeof(struct worker));
+  busy = calloc(nc, sizeof(sqlc_handle_t));
+  rh = calloc(1, sizeof(struct hist));
+  wh = calloc(1, sizeof(struct hist));
+  if (w == NULL || busy == NULL || rh == NULL || wh == NULL) return 1;
+
+  for (i = 0; i < nt; ++i) {
+    w[i].opt = &opt;
+    w[i].writer = (i < opt.writers);
+    w[i].seed = 1 + i;
+    if (i < nc) {
+      w[i].db = sqlc_db_open(opt.db, open_flags(&opt));
+      if (w[i].db < 0) {
+        fprintf(stderr, "open failed: %s\n", sqlite3_errstr(-w[i].db));
+        return 1;
+      }
+      busy[i] = sqlc_db_busy_profile_start(w[i].db, opt.busy_timeout);
+    } else {
+      w[i].db = w[0].db;
+    }
+  }
+
+  __atomic_store_n(&mutex_contended, 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&mutex_wait_ns, 0, __ATOMIC_RELAXED);
+
+  t0 = sqlc_busy_now_ns();
+  for (i = 0; i < nt; ++i) pthread_create(&w[i].thread, NULL, worker_run, &w[i]);
+  sleep(opt.seconds);
+  __atomic_store_n(&stop_flag, 1, __ATOMIC_RELAXED);
+  for (i = 0; i < nt; ++i) pthread_join(w[i].thread, NULL);
+  secs = (sqlc_busy_now_ns() - t0) / 1e9;
+
+  for (i = 0; i < nt; ++i) {
+    if (w[i].error != SQLITE_OK)
+      fprintf(stderr, "%s thread %d: %s\n", w[i].writer ? "writer" : "reader", i, sqlite3_errstr(w[i].error));
+    hist_merge(w[i].writer ? wh : rh, &w[i].h);
+  }
+
+  for (i = 0; i < nc; ++i) {
+    sqlc_long_t v[SQLC_BUSY_STAT_COUNT];
+    int j;
+
+    sqlc_busy_profile_stats(busy[i], v, sizeof v, 0);
+    for (j = 0; j < SQLC_BUSY_STAT_COUNT; ++j) bs[j] += v[j];
+    sqlc_busy_profile_stop(busy[i]);
+    sqlc_db_close(w[i].db);
+  }
+
+  printf("{\n");
+  printf("  \"config\": {\"readers\": %d, \"writers\": %d, \"journal\": \"%s\", \"mutex\": \"%s\", "
+    "\"connections\": \"%s\", \"seconds\": %d, \"rows\": %d, \"busy_timeout_ms\": %d, \"write_batch\": %d, "
+    "\"sqlite\": \"%s\"},\n", opt.readers, opt.writers, opt.journal, opt.fullmutex ? "fullmutex" : "nomutex",
+    opt.shared ? "shared" : "thread", opt.seconds, opt.rows, opt.busy_timeout, opt.write_batch, sqlite3_libversion());
+  printf("  \"elapsed_s\": %.3f,\n", secs);
+  printf("  \"ops_per_s\": %.1f,\n", (rh->count + wh->count) / secs);
+  print_hist("read", rh, secs);
+  print_hist("write", wh, secs);
+  printf("  \"busy_handler\": {\"conflicts\": %lld, \"retries\": %lld, \"wait_ms\": %.3f, \"timeouts\": %lld},\n",
+    bs[SQLC_BUSY_STAT_EVENTS], bs[SQLC_BUSY_STAT_RETRIES], bs[SQLC_BUSY_STAT_WAIT_NS] / 1e6, bs[SQLC_BUSY_STAT_TIMEOUTS]);
+  printf("  \"mutex\": {\"contended\": %lld, \"wait_ms\": %.3f}\n", mutex_contended, mutex_wait_ns / 1e6);
+  printf("}\n");
+
+  return 0;
+}
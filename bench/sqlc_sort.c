@@ -0,0 +1,234 @@
+/* Host benchmark: memory & latency of large sorts & temp b-trees with the temp store in memory
+ * or in temp files that spill above each of some memory thresholds (sqlc_db_temp_store()), built with
+ * the same options as the Android library (make bench).
+ *
+ * usage: sqlc_sort [--key=value ...]
+ *   --db=PATH          database file (default /tmp/sqlc_sort.db, recreated)
+ *   --temp-dir=DIR     directory for temp files (sqlc_temp_directory(), default /tmp)
+ *   --rows=N           rows of about 120 bytes (default 200000)
+ *   --spill-kb=N,...   spill_bytes / 1024 of each run with the temp store in files (up to 8 values,
+ *                      default 256,4096,32768); the run with the temp store in memory keeps the
+ *                      default cache size
+ *   --runs=N           runs of each query in each mode (default 3)
+ *
+ * Prints one JSON report to stdout: for each temp store mode ("memory", "file_<N>kb") & query
+ * (ORDER BY, GROUP BY & DISTINCT on a column without an index) the median & max latency & the SQLite
+ * memory high-water mark (sqlite3_status64(SQLITE_STATUS_MEMORY_USED)) of the runs.
+ * (spill_bytes also limits the page cache of main, which is part of each peak; the ephemeral b-tree
+ * of DISTINCT spills above a fixed size instead: see sqlc_db_temp_store().) */
+
+#include "sqlite3.c"
+
+#include "sqlc.h"
+
+#include "jsmn.c"
+
+#include "sqlc.c"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_SPILLS 8
+
+struct options {
+  const char * db;
+  const char * temp_dir;
+  int rows;
+  int spill_kb[MAX_SPILLS];
+  int spill_count;
+  int runs;
+};
+
+static const struct {
+  const char * name;
+  const char * sql;
+} queries[] = {
+  { "order_by", "SELECT id, v, pad FROM t ORDER BY pad" },
+  { "group_by", "SELECT substr(pad, 1, 6) AS g, count(*), max(v) FROM t GROUP BY g" },
+  { "distinct", "SELECT DISTINCT pad FROM t" },
+};
+
+#define QUERY_COUNT (int)(sizeof(queries) / sizeof(queries[0]))
+#define MAX_RUNS 100
+
+static int exec_sql(sqlc_handle_t db, const char * sql)
+{
+  return sqlite3_exec(HANDLE_TO_VP(db), sql, NULL, NULL, NULL);
+}
+
+static int setup(const struct options * opt)
+{
+  char sql[200];
+  sqlc_handle_t db;
+  int rv;
+
+  unlink(opt->db);
+  snprintf(sql, sizeof sql, "%s-journal", opt->db);
+  unlink(sql);
+
+  db = sqlc_db_open(opt->db, SQLC_OPEN_READWRITE | SQLC_OPEN_CREATE);
+  if (db < 0) return -db;
+
+  rv = exec_sql(db, "CREATE TABLE t(id INTEGER PRIMARY KEY, v INTEGER, pad TEXT)");
+  if (rv == SQLITE_OK) {
+    snprintf(sql, sizeof sql,
+      "WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x+1 FROM c LIMIT %d) "
+      "INSERT INTO t SELECT x, random() %% 1000, hex(randomblob(50)) FROM c", opt->rows);
+    rv = exec_sql(db, sql);
+  }
+
+  sqlc_db_close(db);
+  return rv;
+}
+
+// run a query to the end, returns the number of rows or a negative error
+static sqlc_long_t run_query(sqlc_handle_t db, const char * sql)
+{
+  sqlc_handle_t st = sqlc_db_prepare_st(db, sql);
+  sqlc_long_t n = 0;
+  int rv;
+
+  if (st < 0) return st;
+  while ((rv = sqlc_st_step(st)) == SQLITE_ROW) ++n;
+  sqlc_st_finish(st);
+  return (rv == SQLITE_DONE) ? n : -rv;
+}
+
+static int cmp_long(const void * a, const void * b)
+{
+  sqlc_long_t x = *(const sqlc_long_t *)a, y = *(const sqlc_long_t *)b;
+
+  return (x > y) - (x < y);
+}
+
+// one JSON object of the runs of a query in a temp store mode
+static int bench_query(sqlc_handle_t db, const struct options * opt, int q, bool last)
+{
+  sqlc_long_t ns[MAX_RUNS];
+  sqlc_long_t peak = 0, rows = 0;
+  int i;
+
+  for (i = 0; i < opt->runs; ++i) {
+    sqlite3_int64 cur, hi;
+    sqlc_long_t t0;
+
+    // (reset the high-water mark to the memory in use)
+    sqlite3_status64(SQLITE_STATUS_MEMORY_USED, &cur, &hi, 1);
+    t0 = sqlc_busy_now_ns();
+    rows = run_query(db, queries[q].sql);
+    ns[i] = sqlc_busy_now_ns() - t0;
+    if (rows < 0) {
+      fprintf(stderr, "%s: %s\n", queries[q].name, sqlite3_errstr(-rows));
+      return -rows;
+    }
+    sqlite3_status64(SQLITE_STATUS_MEMORY_USED, &cur, &hi, 0);
+    if (hi > peak) peak = hi;
+  }
+
+  qsort(ns, opt->runs, sizeof(sqlc_long_t), cmp_long);
+  printf("      \"%s\": {\"rows\": %lld, \"p50_ms\": %.3f, \"max_ms\": %.3f, \"peak_mem_kb\": %lld}%s\n",
+    queries[q].name, rows, ns[opt->runs / 2] / 1e6, ns[opt->runs - 1] / 1e6, peak / 1024, last ? "" : ",");
+  return SQLITE_OK;
+}
+
+static int parse_options(int argc, char ** argv, struct options * opt)
+{
+  int i;
+
+  for (i = 1; i < argc; ++i) {
+    const char * a = argv[i];
+    const char * v = strchr(a, '=');
+    size_t kl = (v == NULL) ? strlen(a) : (size_t)(v - a);
+
+    if (v == NULL) return -1;
+    ++v;
+
+#define OPT(k) (kl == strlen(k) && !strncmp(a, k, kl))
+    if (OPT("--db")) opt->db = v;
+    else if (OPT("--temp-dir")) opt->temp_dir = v;
+    else if (OPT("--rows")) opt->rows = atoi(v);
+    else if (OPT("--spill-kb")) {
+      opt->spill_count = 0;
+      while (*v != '\0' && opt->spill_count < MAX_SPILLS) {
+        opt->spill_kb[opt->spill_count++] = atoi(v);
+        v += strcspn(v, ",");
+        if (*v == ',') ++v;
+      }
+      if (*v != '\0') return -1;
+    }
+    else if (OPT("--runs")) opt->runs = atoi(v);
+    else return -1;
+#undef OPT
+  }
+
+  if (opt->rows < 1 || opt->spill_count < 1 || opt->runs < 1 || opt->runs > MAX_RUNS) return -1;
+  for (i = 0; i < opt->spill_count; ++i)
+    if (opt->spill_kb[i] < 1) return -1;
+  return 0;
+}
+
+int main(int argc, char ** argv)
+{
+  struct options opt = { "/tmp/sqlc_sort.db", "/tmp", 200000, { 256, 4096, 32768 }, 3, 3 };
+  char name[40];
+  int m, q, rv;
+
+  if (parse_options(argc, argv, &opt) != 0) {
+    fprintf(stderr, "bad option, see the usage in bench/sqlc_sort.c\n");
+    return 2;
+  }
+
+  rv = sqlc_temp_directory(opt.temp_dir);
+  if (rv == SQLITE_OK) rv = setup(&opt);
+  if (rv != SQLITE_OK) {
+    fprintf(stderr, "setup failed: %s\n", sqlite3_errstr(rv));
+    return 1;
+  }
+
+  printf("{\n");
+  printf("  \"config\": {\"rows\": %d, \"spill_kb\": [", opt.rows);
+  for (m = 0; m < opt.spill_count; ++m) printf("%s%d", (m == 0) ? "" : ", ", opt.spill_kb[m]);
+  printf("], \"runs\": %d, \"temp_dir\": \"%s\", \"sqlite\": \"%s\"},\n",
+    opt.runs, opt.temp_dir, sqlite3_libversion());
+  printf("  \"modes\": {\n");
+
+  // memory, then files with each spill threshold:
+  for (m = -1; m < opt.spill_count; ++m) {
+    sqlc_handle_t db = sqlc_db_open(opt.db, SQLC_OPEN_READWRITE);
+
+    if (db < 0) {
+      fprintf(stderr, "open failed: %s\n", sqlite3_errstr(-db));
+      return 1;
+    }
+
+    if (m < 0) {
+      snprintf(name, sizeof name, "memory");
+      rv = sqlc_db_temp_store(db, SQLC_TEMP_STORE_MEMORY, 0);
+    } else {
+      snprintf(name, sizeof name, "file_%dkb", opt.spill_kb[m]);
+      rv = sqlc_db_temp_store(db, SQLC_TEMP_STORE_FILE, (sqlc_long_t)opt.spill_kb[m] * 1024);
+    }
+    // (the database file is read once before the first query)
+    if (rv == SQLITE_OK && run_query(db, "SELECT count(*), sum(length(pad)) FROM t") < 0) rv = SQLITE_ERROR;
+    if (rv != SQLITE_OK) {
+      fprintf(stderr, "%s: %s\n", name, sqlite3_errstr(rv));
+      return 1;
+    }
+
+    printf("    \"%s\": {\n", name);
+    for (q = 0; q < QUERY_COUNT; ++q) {
+      if (bench_query(db, &opt, q, q == QUERY_COUNT - 1) != SQLITE_OK) return 1;
+    }
+    printf("    }%s\n", (m == opt.spill_count - 1) ? "" : ",");
+
+    sqlc_db_close(db);
+  }
+
+  printf("  }\n");
+  printf("}\n");
+
+  sqlc_temp_directory(NULL);
+  unlink(opt.db);
+  return 0;
+}
@@ -24,6 +24,8 @@ public class SQLiteNative {
   public static final int SQLC_RESULT_INTERNAL = 2;
   public static final int SQLC_RESULT_PERM = 3;
   public static final int SQLC_RESULT_ABORT = 4;
+  public static final int SQLC_RESULT_INTERRUPT = 9;
+  public static final int SQLC_RESULT_NOTFOUND = 12;
   public static final int SQLC_RESULT_CONSTRAINT = 19;
   public static final int SQLC_RESULT_MISMATCH = 20;
   public static final int SQLC_RESULT_MISUSE = 21;
@@ -34,6 +36,97 @@ public class SQLiteNative {
   public static final int SQLC_TEXT = 3;
   public static final int SQLC_BLOB = 4;
   public static final int SQLC_NULL = 5;
+  public static final int SQLC_TRACE_STMT = 0x01;
+  public static final int SQLC_TRACE_PROFILE = 0x02;
+  public static final int SQLC_TRACE_ROW = 0x04;
+  public static final int SQLC_TRACE_CLOSE = 0x08;
+  public static final int SQLC_STAT_CACHE_USED = 0;
+  public static final int SQLC_STAT_CACHE_USED_SHARED = 1;
+  public static final int SQLC_STAT_CACHE_HIT = 2;
+  public static final int SQLC_STAT_CACHE_MISS = 3;
+  public static final int SQLC_STAT_CACHE_WRITE = 4;
+  public static final int SQLC_STAT_CACHE_SPILL = 5;
+  public static final int SQLC_STAT_LOOKASIDE_USED = 6;
+  public static final int SQLC_STAT_LOOKASIDE_USED_HIGHWATER = 7;
+  public static final int SQLC_STAT_LOOKASIDE_HIT = 8;
+  public static final int SQLC_STAT_LOOKASIDE_MISS_SIZE = 9;
+  public static final int SQLC_STAT_LOOKASIDE_MISS_FULL = 10;
+  public static final int SQLC_STAT_SCHEMA_USED = 11;
+  public static final int SQLC_STAT_STMT_USED = 12;
+  public static final int SQLC_STAT_MEMORY_USED = 13;
+  public static final int SQLC_STAT_MEMORY_USED_HIGHWATER = 14;
+  public static final int SQLC_STAT_MALLOC_COUNT = 15;
+  public static final int SQLC_STAT_MALLOC_COUNT_HIGHWATER = 16;
+  public static final int SQLC_STAT_MALLOC_SIZE_HIGHWATER = 17;
+  public static final int SQLC_STAT_PAGECACHE_USED = 18;
+  public static final int SQLC_STAT_PAGECACHE_OVERFLOW = 19;
+  public static final int SQLC_STAT_PAGECACHE_OVERFLOW_HIGHWATER = 20;
+  public static final int SQLC_STAT_PAGECACHE_SIZE_HIGHWATER = 21;
+  public static final int SQLC_STAT_COUNT = 22;
+  public static final int SQLC_FJ_STAT_RUN_ALLOCS = 0;
+  public static final int SQLC_FJ_STAT_RUN_BYTES = 1;
+  public static final int SQLC_FJ_STAT_RUN_COPIED = 2;
+  public static final int SQLC_FJ_STAT_RUN_PEAK = 3;
+  public static final int SQLC_FJ_STAT_TOTAL_ALLOCS = 4;
+  public static final int SQLC_FJ_STAT_TOTAL_BYTES = 5;
+  public static final int SQLC_FJ_STAT_TOTAL_COPIED = 6;
+  public static final int SQLC_FJ_STAT_TOTAL_PEAK = 7;
+  public static final int SQLC_FJ_STAT_COUNT = 8;
+  public static final int SQLC_EXPORT_NDJSON = 1;
+  public static final int SQLC_EXPORT_CSV = 2;
+  public static final int SQLC_EXPORT_STAT_ROWS = 0;
+  public static final int SQLC_EXPORT_STAT_BYTES = 1;
+  public static final int SQLC_EXPORT_STAT_COUNT = 2;
+  public static final int SQLC_IMPORT_STAT_ROWS = 0;
+  public static final int SQLC_IMPORT_STAT_INSERTED = 1;
+  public static final int SQLC_IMPORT_STAT_ERRORS = 2;
+  public static final int SQLC_IMPORT_STAT_BYTES = 3;
+  public static final int SQLC_IMPORT_STAT_COUNT = 4;
+  public static final int SQLC_IMPORT_DEFAULT_CHUNK = 5000;
+  public static final int SQLC_WARMUP_STAT_PAGES = 0;
+  public static final int SQLC_WARMUP_STAT_BYTES = 1;
+  public static final int SQLC_WARMUP_STAT_MS = 2;
+  public static final int SQLC_WARMUP_STAT_COUNT = 3;
+  public static final String SQLC_RANGE_VFS = "sqlc_range";
+  public static final int SQLC_DESERIALIZE_READONLY = 0x04;
+  public static final int SQLC_FUNC_REGEXP = 0x01;
+  public static final int SQLC_FUNC_HASH = 0x02;
+  public static final int SQLC_FUNC_GEO = 0x04;
+  public static final int SQLC_FUNC_ALL = 0x07;
+  public static final int SQLC_MEM_STAT_USED = 0;
+  public static final int SQLC_MEM_STAT_HIGHWATER = 1;
+  public static final int SQLC_MEM_STAT_SOFT_LIMIT = 2;
+  public static final int SQLC_MEM_STAT_HARD_LIMIT = 3;
+  public static final int SQLC_MEM_STAT_FJ_RETAINED = 4;
+  public static final int SQLC_MEM_STAT_COUNT = 5;
+  public static final int SQLC_MAINTAIN_CHECKPOINT = 0x01;
+  public static final int SQLC_MAINTAIN_CHECKPOINT_RESTART = 0x02;
+  public static final int SQLC_MAINTAIN_VACUUM = 0x04;
+  public static final int SQLC_MAINTAIN_OPTIMIZE = 0x08;
+  public static final int SQLC_MAINTAIN_STAT_WAL_FRAMES = 0;
+  public static final int SQLC_MAINTAIN_STAT_CHECKPOINTED = 1;
+  public static final int SQLC_MAINTAIN_STAT_PAGES_FREED = 2;
+  public static final int SQLC_MAINTAIN_STAT_FREELIST = 3;
+  public static final int SQLC_MAINTAIN_STAT_MS = 4;
+  public static final int SQLC_MAINTAIN_STAT_COUNT = 5;
+  public static final int SQLC_CHANGES_MAX_TABLES = 256;
+  public static final int SQLC_TEMP_STORE_DEFAULT = 0;
+  public static final int SQLC_TEMP_STORE_FILE = 1;
+  public static final int SQLC_TEMP_STORE_MEMORY = 2;
+  public static final int SQLC_CHANGESET_OMIT = 0;
+  public static final int SQLC_CHANGESET_REPLACE = 1;
+  public static final int SQLC_CHANGESET_ABORT = 2;
+  public static final int SQLC_CHANGESET_STAT_DATA = 0;
+  public static final int SQLC_CHANGESET_STAT_NOTFOUND = 1;
+  public static final int SQLC_CHANGESET_STAT_CONFLICT = 2;
+  public static final int SQLC_CHANGESET_STAT_CONSTRAINT = 3;
+  public static final int SQLC_CHANGESET_STAT_FOREIGN_KEY = 4;
+  public static final int SQLC_CHANGESET_STAT_COUNT = 5;
+  public static final int SQLC_BUSY_STAT_EVENTS = 0;
+  public static final int SQLC_BUSY_STAT_RETRIES = 1;
+  public static final int SQLC_BUSY_STAT_WAIT_NS = 2;
+  public static final int SQLC_BUSY_STAT_TIMEOUTS = 3;
+  public static final int SQLC_BUSY_STAT_COUNT = 4;
 
   /** Interface to C language function: <br> <code> sqlc_handle_t sqlc_api_db_open(int sqlc_api_version, const char *  filename, int flags); </code>    */
   public static native long sqlc_api_db_open(int sqlc_api_version, String filename, int flags);
@@ -41,42 +134,337 @@ public class SQLiteNative {
   /** Interface to C language function: <br> <code> int sqlc_api_version_check(int sqlc_api_version); </code>    */
   public static native int sqlc_api_version_check(int sqlc_api_version);
 
+  /** Interface to C language function: <br> <code> int sqlc_backup_finish(sqlc_handle_t backup); </code>    */
+  public static native int sqlc_backup_finish(long backup);
+
+  /** Interface to C language function: <br> <code> sqlc_handle_t sqlc_backup_init(sqlc_handle_t dest_db, const char *  dest_name, sqlc_handle_t src_db, const char *  src_name); </code>    */
+  public static native long sqlc_backup_init(long dest_db, String dest_name, long src_db, String src_name);
+
+  /** Interface to C language function: <br> <code> int sqlc_backup_pagecount(sqlc_handle_t backup); </code>    */
+  public static native int sqlc_backup_pagecount(long backup);
+
+  /** Interface to C language function: <br> <code> int sqlc_backup_remaining(sqlc_handle_t backup); </code>    */
+  public static native int sqlc_backup_remaining(long backup);
+
+  /** Interface to C language function: <br> <code> int sqlc_backup_step(sqlc_handle_t backup, int pages); </code>    */
+  public static native int sqlc_backup_step(long backup, int pages);
+
+  /** Interface to C language function: <br> <code> int sqlc_blob_bytes(sqlc_handle_t blob); </code>    */
+  public static native int sqlc_blob_bytes(long blob);
+
+  /** Interface to C language function: <br> <code> int sqlc_blob_close(sqlc_handle_t blob); </code>    */
+  public static native int sqlc_blob_close(long blob);
+
+  /** Interface to C language function: <br> <code> sqlc_handle_t sqlc_blob_open(sqlc_handle_t db, const char *  db_name, const char *  table, const char *  column, sqlc_long_t row, int flags); </code>    */
+  public static native long sqlc_blob_open(long db, String db_name, String table, String column, long row, int flags);
+
+  /** Interface to C language function: <br> <code> int sqlc_blob_read(sqlc_handle_t blob, void *  buf, int n, int offset); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  public static int sqlc_blob_read(long blob, java.nio.ByteBuffer buf, int n, int offset)  {
+
+    if (!buf.isDirect())
+      throw new RuntimeException("Argument \"buf\" is not a direct buffer");
+        return sqlc_blob_read0(blob, buf, buf.position(), n, offset);
+  }
+
+  /** Entry point to C language function: <code> int sqlc_blob_read(sqlc_handle_t blob, void *  buf, int n, int offset); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  private static native int sqlc_blob_read0(long blob, java.lang.Object buf, int buf_byte_offset, int n, int offset);
+
+  /** Interface to C language function: <br> <code> int sqlc_blob_reopen(sqlc_handle_t blob, sqlc_long_t row); </code>    */
+  public static native int sqlc_blob_reopen(long blob, long row);
+
+  /** Interface to C language function: <br> <code> int sqlc_blob_write(sqlc_handle_t blob, const void *  buf, int n, int offset); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  public static int sqlc_blob_write(long blob, java.nio.ByteBuffer buf, int n, int offset)  {
+
+    if (!buf.isDirect())
+      throw new RuntimeException("Argument \"buf\" is not a direct buffer");
+        return sqlc_blob_write0(blob, buf, buf.position(), n, offset);
+  }
+
+  /** Entry point to C language function: <code> int sqlc_blob_write(sqlc_handle_t blob, const void *  buf, int n, int offset); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  private static native int sqlc_blob_write0(long blob, java.lang.Object buf, int buf_byte_offset, int n, int offset);
+
+  /** Interface to C language function: <br> <code> int sqlc_busy_profile_stats(sqlc_handle_t busy, void *  buf, int len, int reset); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  public static int sqlc_busy_profile_stats(long busy, java.nio.ByteBuffer buf, int len, int reset)  {
+
+    if (!buf.isDirect())
+      throw new RuntimeException("Argument \"buf\" is not a direct buffer");
+        return sqlc_busy_profile_stats0(busy, buf, buf.position(), len, reset);
+  }
+
+  /** Entry point to C language function: <code> int sqlc_busy_profile_stats(sqlc_handle_t busy, void *  buf, int len, int reset); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  private static native int sqlc_busy_profile_stats0(long busy, java.lang.Object buf, int buf_byte_offset, int len, int reset);
+
+  /** Interface to C language function: <br> <code> int sqlc_busy_profile_stop(sqlc_handle_t busy); </code>    */
+  public static native int sqlc_busy_profile_stop(long busy);
+
+  /** Interface to C language function: <br> <code> int sqlc_changes_drain(sqlc_handle_t changes, void *  buf, int len); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  public static int sqlc_changes_drain(long changes, java.nio.ByteBuffer buf, int len)  {
+
+    if (!buf.isDirect())
+      throw new RuntimeException("Argument \"buf\" is not a direct buffer");
+        return sqlc_changes_drain0(changes, buf, buf.position(), len);
+  }
+
+  /** Entry point to C language function: <code> int sqlc_changes_drain(sqlc_handle_t changes, void *  buf, int len); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  private static native int sqlc_changes_drain0(long changes, java.lang.Object buf, int buf_byte_offset, int len);
+
+  /** Interface to C language function: <br> <code> sqlc_long_t sqlc_changes_dropped(sqlc_handle_t changes); </code>    */
+  public static native long sqlc_changes_dropped(long changes);
+
+  /** Interface to C language function: <br> <code> int sqlc_changes_stop(sqlc_handle_t changes); </code>    */
+  public static native int sqlc_changes_stop(long changes);
+
+  /** Interface to C language function: <br> <code> const char *  sqlc_changes_table_name(sqlc_handle_t changes, int id); </code>    */
+  public static native String sqlc_changes_table_name(long changes, int id);
+
+  /** Interface to C language function: <br> <code> sqlc_handle_t sqlc_db_busy_profile_start(sqlc_handle_t db, int timeout_ms); </code>    */
+  public static native long sqlc_db_busy_profile_start(long db, int timeout_ms);
+
+  /** Interface to C language function: <br> <code> sqlc_handle_t sqlc_db_changes_start(sqlc_handle_t db, int capacity); </code>    */
+  public static native long sqlc_db_changes_start(long db, int capacity);
+
+  /** Interface to C language function: <br> <code> int sqlc_db_changeset_apply(sqlc_handle_t db, const void *  buf, int len, int policy, void *  stats, int slen); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   <br>@param stats a direct only {@link java.nio.ByteBuffer}   */
+  public static int sqlc_db_changeset_apply(long db, java.nio.ByteBuffer buf, int len, int policy, java.nio.ByteBuffer stats, int slen)  {
+
+    if (!buf.isDirect())
+      throw new RuntimeException("Argument \"buf\" is not a direct buffer");
+    if (!stats.isDirect())
+      throw new RuntimeException("Argument \"stats\" is not a direct buffer");
+        return sqlc_db_changeset_apply0(db, buf, buf.position(), len, policy, stats, stats.position(), slen);
+  }
+
+  /** Entry point to C language function: <code> int sqlc_db_changeset_apply(sqlc_handle_t db, const void *  buf, int len, int policy, void *  stats, int slen); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   <br>@param stats a direct only {@link java.nio.ByteBuffer}   */
+  private static native int sqlc_db_changeset_apply0(long db, java.lang.Object buf, int buf_byte_offset, int len, int policy, java.lang.Object stats, int stats_byte_offset, int slen);
+
   /** Interface to C language function: <br> <code> int sqlc_db_close(sqlc_handle_t db); </code>    */
   public static native int sqlc_db_close(long db);
 
+  /** Interface to C language function: <br> <code> int sqlc_db_deserialize(sqlc_handle_t db, const char *  schema, void *  buf, sqlc_long_t size, int flags); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  public static int sqlc_db_deserialize(long db, String schema, java.nio.ByteBuffer buf, long size, int flags)  {
+
+    if (!buf.isDirect())
+      throw new RuntimeException("Argument \"buf\" is not a direct buffer");
+        return sqlc_db_deserialize0(db, schema, buf, buf.position(), size, flags);
+  }
+
+  /** Entry point to C language function: <code> int sqlc_db_deserialize(sqlc_handle_t db, const char *  schema, void *  buf, sqlc_long_t size, int flags); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  private static native int sqlc_db_deserialize0(long db, String schema, java.lang.Object buf, int buf_byte_offset, long size, int flags);
+
+  /** Interface to C language function: <br> <code> int sqlc_db_deserialize_file(sqlc_handle_t db, const char *  schema, const char *  path, sqlc_long_t offset, sqlc_long_t size, int flags); </code>    */
+  public static native int sqlc_db_deserialize_file(long db, String schema, String path, long offset, long size, int flags);
+
   /** Interface to C language function: <br> <code> int sqlc_db_errcode(sqlc_handle_t db); </code>    */
   public static native int sqlc_db_errcode(long db);
 
   /** Interface to C language function: <br> <code> const char *  sqlc_db_errmsg_native(sqlc_handle_t db); </code>    */
   public static native String sqlc_db_errmsg_native(long db);
 
+  /** Interface to C language function: <br> <code> int sqlc_db_export(sqlc_handle_t db, const char *  sql, const char *  params, const char *  path, int format, void *  stats, int len); </code>    <br>@param stats a direct only {@link java.nio.ByteBuffer}   */
+  public static int sqlc_db_export(long db, String sql, String params, String path, int format, java.nio.ByteBuffer stats, int len)  {
+
+    if (!stats.isDirect())
+      throw new RuntimeException("Argument \"stats\" is not a direct buffer");
+        return sqlc_db_export0(db, sql, params, path, format, stats, stats.position(), len);
+  }
+
+  /** Entry point to C language function: <code> int sqlc_db_export(sqlc_handle_t db, const char *  sql, const char *  params, const char *  path, int format, void *  stats, int len); </code>    <br>@param stats a direct only {@link java.nio.ByteBuffer}   */
+  private static native int sqlc_db_export0(long db, String sql, String params, String path, int format, java.lang.Object stats, int stats_byte_offset, int len);
+
+  /** Interface to C language function: <br> <code> int sqlc_db_import(sqlc_handle_t db, const char *  path, int format, const char *  sql, int chunk_rows, void *  stats, int len); </code>    <br>@param stats a direct only {@link java.nio.ByteBuffer}   */
+  public static int sqlc_db_import(long db, String path, int format, String sql, int chunk_rows, java.nio.ByteBuffer stats, int len)  {
+
+    if (!stats.isDirect())
+      throw new RuntimeException("Argument \"stats\" is not a direct buffer");
+        return sqlc_db_import0(db, path, format, sql, chunk_rows, stats, stats.position(), len);
+  }
+
+  /** Entry point to C language function: <code> int sqlc_db_import(sqlc_handle_t db, const char *  path, int format, const char *  sql, int chunk_rows, void *  stats, int len); </code>    <br>@param stats a direct only {@link java.nio.ByteBuffer}   */
+  private static native int sqlc_db_import0(long db, String path, int format, String sql, int chunk_rows, java.lang.Object stats, int stats_byte_offset, int len);
+
+  /** Interface to C language function: <br> <code> void sqlc_db_interrupt(sqlc_handle_t db); </code>    */
+  public static native void sqlc_db_interrupt(long db);
+
   /** Interface to C language function: <br> <code> int sqlc_db_key_native_string(sqlc_handle_t db, char *  key_string); </code>    */
   public static native int sqlc_db_key_native_string(long db, String key_string);
 
   /** Interface to C language function: <br> <code> sqlc_long_t sqlc_db_last_insert_rowid(sqlc_handle_t db); </code>    */
   public static native long sqlc_db_last_insert_rowid(long db);
 
+  /** Interface to C language function: <br> <code> int sqlc_db_maintain(sqlc_handle_t db, int budget_ms, int flags, void *  stats, int len); </code>    <br>@param stats a direct only {@link java.nio.ByteBuffer}   */
+  public static int sqlc_db_maintain(long db, int budget_ms, int flags, java.nio.ByteBuffer stats, int len)  {
+
+    if (!stats.isDirect())
+      throw new RuntimeException("Argument \"stats\" is not a direct buffer");
+        return sqlc_db_maintain0(db, budget_ms, flags, stats, stats.position(), len);
+  }
+
+  /** Entry point to C language function: <code> int sqlc_db_maintain(sqlc_handle_t db, int budget_ms, int flags, void *  stats, int len); </code>    <br>@param stats a direct only {@link java.nio.ByteBuffer}   */
+  private static native int sqlc_db_maintain0(long db, int budget_ms, int flags, java.lang.Object stats, int stats_byte_offset, int len);
+
   /** Interface to C language function: <br> <code> sqlc_handle_t sqlc_db_new_fj(sqlc_handle_t db); </code>    */
   public static native long sqlc_db_new_fj(long db);
 
   /** Interface to C language function: <br> <code> sqlc_handle_t sqlc_db_open(const char *  filename, int flags); </code>    */
   public static native long sqlc_db_open(String filename, int flags);
 
+  /** Interface to C language function: <br> <code> sqlc_handle_t sqlc_db_open_vfs(const char *  filename, int flags, const char *  vfs); </code>    */
+  public static native long sqlc_db_open_vfs(String filename, int flags, String vfs);
+
   /** Interface to C language function: <br> <code> sqlc_handle_t sqlc_db_prepare_st(sqlc_handle_t db, const char *  sql); </code>    */
   public static native long sqlc_db_prepare_st(long db, String sql);
 
+  /** Interface to C language function: <br> <code> int sqlc_db_register_functions(sqlc_handle_t db, int mask); </code>    */
+  public static native int sqlc_db_register_functions(long db, int mask);
+
+  /** Interface to C language function: <br> <code> sqlc_long_t sqlc_db_release_memory(sqlc_handle_t db); </code>    */
+  public static native long sqlc_db_release_memory(long db);
+
+  /** Interface to C language function: <br> <code> sqlc_long_t sqlc_db_serialize(sqlc_handle_t db, const char *  schema, void *  buf, sqlc_long_t len); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  public static long sqlc_db_serialize(long db, String schema, java.nio.ByteBuffer buf, long len)  {
+
+    if (!buf.isDirect())
+      throw new RuntimeException("Argument \"buf\" is not a direct buffer");
+        return sqlc_db_serialize0(db, schema, buf, buf.position(), len);
+  }
+
+  /** Entry point to C language function: <code> sqlc_long_t sqlc_db_serialize(sqlc_handle_t db, const char *  schema, void *  buf, sqlc_long_t len); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  private static native long sqlc_db_serialize0(long db, String schema, java.lang.Object buf, int buf_byte_offset, long len);
+
+  /** Interface to C language function: <br> <code> sqlc_handle_t sqlc_db_session_new(sqlc_handle_t db, const char *  schema); </code>    */
+  public static native long sqlc_db_session_new(long db, String schema);
+
+  /** Interface to C language function: <br> <code> int sqlc_db_stats(sqlc_handle_t db, void *  buf, int len, int reset); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  public static int sqlc_db_stats(long db, java.nio.ByteBuffer buf, int len, int reset)  {
+
+    if (!buf.isDirect())
+      throw new RuntimeException("Argument \"buf\" is not a direct buffer");
+        return sqlc_db_stats0(db, buf, buf.position(), len, reset);
+  }
+
+  /** Entry point to C language function: <code> int sqlc_db_stats(sqlc_handle_t db, void *  buf, int len, int reset); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  private static native int sqlc_db_stats0(long db, java.lang.Object buf, int buf_byte_offset, int len, int reset);
+
+  /** Interface to C language function: <br> <code> int sqlc_db_temp_store(sqlc_handle_t db, int mode, sqlc_long_t spill_bytes); </code>    */
+  public static native int sqlc_db_temp_store(long db, int mode, long spill_bytes);
+
   /** Interface to C language function: <br> <code> int sqlc_db_total_changes(sqlc_handle_t db); </code>    */
   public static native int sqlc_db_total_changes(long db);
 
+  /** Interface to C language function: <br> <code> sqlc_long_t sqlc_db_total_changes64(sqlc_handle_t db); </code>    */
+  public static native long sqlc_db_total_changes64(long db);
+
+  /** Interface to C language function: <br> <code> sqlc_handle_t sqlc_db_trace_start(sqlc_handle_t db, int mask, int capacity); </code>    */
+  public static native long sqlc_db_trace_start(long db, int mask, int capacity);
+
+  /** Interface to C language function: <br> <code> int sqlc_db_warmup(sqlc_handle_t db, const char *  names, sqlc_long_t max_bytes, void *  stats, int len); </code>    <br>@param stats a direct only {@link java.nio.ByteBuffer}   */
+  public static int sqlc_db_warmup(long db, String names, long max_bytes, java.nio.ByteBuffer stats, int len)  {
+
+    if (!stats.isDirect())
+      throw new RuntimeException("Argument \"stats\" is not a direct buffer");
+        return sqlc_db_warmup0(db, names, max_bytes, stats, stats.position(), len);
+  }
+
+  /** Entry point to C language function: <code> int sqlc_db_warmup(sqlc_handle_t db, const char *  names, sqlc_long_t max_bytes, void *  stats, int len); </code>    <br>@param stats a direct only {@link java.nio.ByteBuffer}   */
+  private static native int sqlc_db_warmup0(long db, String names, long max_bytes, java.lang.Object stats, int stats_byte_offset, int len);
+
   /** Interface to C language function: <br> <code> const char *  sqlc_errstr_native(int errcode); </code>    */
   public static native String sqlc_errstr_native(int errcode);
 
+  /** Interface to C language function: <br> <code> int sqlc_fj_alloc_stats(sqlc_handle_t fj, void *  buf, int len); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  public static int sqlc_fj_alloc_stats(long fj, java.nio.ByteBuffer buf, int len)  {
+
+    if (!buf.isDirect())
+      throw new RuntimeException("Argument \"buf\" is not a direct buffer");
+        return sqlc_fj_alloc_stats0(fj, buf, buf.position(), len);
+  }
+
+  /** Entry point to C language function: <code> int sqlc_fj_alloc_stats(sqlc_handle_t fj, void *  buf, int len); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  private static native int sqlc_fj_alloc_stats0(long fj, java.lang.Object buf, int buf_byte_offset, int len);
+
   /** Interface to C language function: <br> <code> void sqlc_fj_dispose(sqlc_handle_t fj); </code>    */
   public static native void sqlc_fj_dispose(long fj);
 
+  /** Interface to C language function: <br> <code> int sqlc_fj_register_sql(sqlc_handle_t fj, const char *  sql); </code>    */
+  public static native int sqlc_fj_register_sql(long fj, String sql);
+
   /** Interface to C language function: <br> <code> const char *  sqlc_fj_run(sqlc_handle_t fj, const char *  batch_json, int ll); </code>    */
   public static native String sqlc_fj_run(long fj, String batch_json, int ll);
 
+  /** Interface to C language function: <br> <code> int sqlc_fj_set_budget(sqlc_handle_t fj, int ms, sqlc_long_t vm_steps); </code>    */
+  public static native int sqlc_fj_set_budget(long fj, int ms, long vm_steps);
+
+  /** Interface to C language function: <br> <code> int sqlc_fj_set_cache(sqlc_handle_t fj, int max_bytes); </code>    */
+  public static native int sqlc_fj_set_cache(long fj, int max_bytes);
+
+  /** Interface to C language function: <br> <code> void sqlc_fj_set_pipeline(sqlc_handle_t fj, int enable); </code>    */
+  public static native void sqlc_fj_set_pipeline(long fj, int enable);
+
+  /** Interface to C language function: <br> <code> sqlc_long_t sqlc_hard_heap_limit(sqlc_long_t n); </code>    */
+  public static native long sqlc_hard_heap_limit(long n);
+
+  /** Interface to C language function: <br> <code> int sqlc_memory_stats(void *  buf, int len); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  public static int sqlc_memory_stats(java.nio.ByteBuffer buf, int len)  {
+
+    if (!buf.isDirect())
+      throw new RuntimeException("Argument \"buf\" is not a direct buffer");
+        return sqlc_memory_stats0(buf, buf.position(), len);
+  }
+
+  /** Entry point to C language function: <code> int sqlc_memory_stats(void *  buf, int len); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  private static native int sqlc_memory_stats0(java.lang.Object buf, int buf_byte_offset, int len);
+
+  /** Interface to C language function: <br> <code> int sqlc_multi_add(sqlc_handle_t multi, sqlc_handle_t fj, const char *  batch_json, int ll); </code>    */
+  public static native int sqlc_multi_add(long multi, long fj, String batch_json, int ll);
+
+  /** Interface to C language function: <br> <code> void sqlc_multi_dispose(sqlc_handle_t multi); </code>    */
+  public static native void sqlc_multi_dispose(long multi);
+
+  /** Interface to C language function: <br> <code> sqlc_handle_t sqlc_multi_new(int max_threads); </code>    */
+  public static native long sqlc_multi_new(int max_threads);
+
+  /** Interface to C language function: <br> <code> const char *  sqlc_multi_run(sqlc_handle_t multi); </code>    */
+  public static native String sqlc_multi_run(long multi);
+
+  /** Interface to C language function: <br> <code> int sqlc_range_vfs_register(); </code>    */
+  public static native int sqlc_range_vfs_register();
+
+  /** Interface to C language function: <br> <code> sqlc_long_t sqlc_release_memory(); </code>    */
+  public static native long sqlc_release_memory();
+
+  /** Interface to C language function: <br> <code> int sqlc_session_attach(sqlc_handle_t session, const char *  table); </code>    */
+  public static native int sqlc_session_attach(long session, String table);
+
+  /** Interface to C language function: <br> <code> int sqlc_session_changeset(sqlc_handle_t session, int patchset, void *  buf, int len); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  public static int sqlc_session_changeset(long session, int patchset, java.nio.ByteBuffer buf, int len)  {
+
+    if (!buf.isDirect())
+      throw new RuntimeException("Argument \"buf\" is not a direct buffer");
+        return sqlc_session_changeset0(session, patchset, buf, buf.position(), len);
+  }
+
+  /** Entry point to C language function: <code> int sqlc_session_changeset(sqlc_handle_t session, int patchset, void *  buf, int len); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  private static native int sqlc_session_changeset0(long session, int patchset, java.lang.Object buf, int buf_byte_offset, int len);
+
+  /** Interface to C language function: <br> <code> int sqlc_session_delete(sqlc_handle_t session); </code>    */
+  public static native int sqlc_session_delete(long session);
+
+  /** Interface to C language function: <br> <code> int sqlc_session_enable(sqlc_handle_t session, int enable); </code>    */
+  public static native int sqlc_session_enable(long session, int enable);
+
+  /** Interface to C language function: <br> <code> sqlc_long_t sqlc_soft_heap_limit(sqlc_long_t n); </code>    */
+  public static native long sqlc_soft_heap_limit(long n);
+
+  /** Interface to C language function: <br> <code> int sqlc_st_bind_all(sqlc_handle_t st, const void *  buf, int len); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  public static int sqlc_st_bind_all(long st, java.nio.ByteBuffer buf, int len)  {
+
+    if (!buf.isDirect())
+      throw new RuntimeException("Argument \"buf\" is not a direct buffer");
+        return sqlc_st_bind_all0(st, buf, buf.position(), len);
+  }
+
+  /** Entry point to C language function: <code> int sqlc_st_bind_all(sqlc_handle_t st, const void *  buf, int len); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  private static native int sqlc_st_bind_all0(long st, java.lang.Object buf, int buf_byte_offset, int len);
+
   /** Interface to C language function: <br> <code> int sqlc_st_bind_double(sqlc_handle_t st, int pos, double val); </code>    */
   public static native int sqlc_st_bind_double(long st, int pos, double val);
 
@@ -92,6 +480,9 @@ public class SQLiteNative {
   /** Interface to C language function: <br> <code> int sqlc_st_bind_text_native(sqlc_handle_t st, int col, const char *  val); </code>    */
   public static native int sqlc_st_bind_text_native(long st, int col, String val);
 
+  /** Interface to C language function: <br> <code> int sqlc_st_clear_bindings(sqlc_handle_t st); </code>    */
+  public static native int sqlc_st_clear_bindings(long st);
+
   /** Interface to C language function: <br> <code> int sqlc_st_column_count(sqlc_handle_t st); </code>    */
   public static native int sqlc_st_column_count(long st);
 
@@ -116,8 +507,31 @@ public class SQLiteNative {
   /** Interface to C language function: <br> <code> int sqlc_st_finish(sqlc_handle_t st); </code>    */
   public static native int sqlc_st_finish(long st);
 
+  /** Interface to C language function: <br> <code> int sqlc_st_reset(sqlc_handle_t st); </code>    */
+  public static native int sqlc_st_reset(long st);
+
   /** Interface to C language function: <br> <code> int sqlc_st_step(sqlc_handle_t st); </code>    */
   public static native int sqlc_st_step(long st);
 
+  /** Interface to C language function: <br> <code> int sqlc_temp_directory(const char *  dir); </code>    */
+  public static native int sqlc_temp_directory(String dir);
+
+  /** Interface to C language function: <br> <code> int sqlc_trace_drain(sqlc_handle_t trace, void *  buf, int len); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  public static int sqlc_trace_drain(long trace, java.nio.ByteBuffer buf, int len)  {
+
+    if (!buf.isDirect())
+      throw new RuntimeException("Argument \"buf\" is not a direct buffer");
+        return sqlc_trace_drain0(trace, buf, buf.position(), len);
+  }
+
+  /** Entry point to C language function: <code> int sqlc_trace_drain(sqlc_handle_t trace, void *  buf, int len); </code>    <br>@param buf a direct only {@link java.nio.ByteBuffer}   */
+  private static native int sqlc_trace_drain0(long trace, java.lang.Object buf, int buf_byte_offset, int len);
+
+  /** Interface to C language function: <br> <code> sqlc_long_t sqlc_trace_dropped(sqlc_handle_t trace); </code>    */
+  public static native long sqlc_trace_dropped(long trace);
+
+  /** Interface to C language function: <br> <code> int sqlc_trace_stop(sqlc_handle_t trace); </code>    */
+  public static native int sqlc_trace_stop(long trace);
+
 
 } // end of class SQLiteNative
@@ -5,8 +5,15 @@ include $(CLEAR_VARS)
 LOCAL_LDLIBS := -llog
 LOCAL_MODULE    := sqlc-native-driver
 LOCAL_C_INCLUDES := $(LOCAL_PATH)/../sqlite-amalgamation
+# temp store in memory by default, per connection with sqlc_db_temp_store():
 LOCAL_CFLAGS += -DSQLITE_TEMP_STORE=2 -DSQLITE_THREADSAFE=2
+# for sqlite3_release_memory() (sqlc_release_memory):
+LOCAL_CFLAGS += -DSQLITE_ENABLE_MEMORY_MANAGEMENT
+# session extension for changesets (sqlc_db_session_new etc.):
+LOCAL_CFLAGS += -DSQLITE_ENABLE_SESSION -DSQLITE_ENABLE_PREUPDATE_HOOK
 LOCAL_CFLAGS += -DSQLITE_ENABLE_FTS3 -DSQLITE_ENABLE_FTS3_PARENTHESIS -DSQLITE_ENABLE_FTS4 -DSQLITE_ENABLE_RTREE
+# Batch runner allocation accounting (sqlc_fj_alloc_stats):
+#LOCAL_CFLAGS += -DSQLC_FJ_STATS
 LOCAL_SRC_FILES := ../native/sqlc_all.c
 include $(BUILD_SHARED_LIBRARY)
 
@@ -44,66 +44,1075 @@ Java_io_liteglue_SQLiteNative_sqlc_1api_1version_1check__I(JNIEnv *env, jclass _
 }
 
 
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_backup_finish(long backup)
+ *     C function: int sqlc_backup_finish(sqlc_handle_t backup);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1backup_1finish__J(JNIEnv *env, jclass _unused, jlong backup) {
+  int _res;
+  _res = sqlc_backup_finish((sqlc_handle_t) backup);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: long sqlc_backup_init(long dest_db, java.lang.String dest_name, long src_db, java.lang.String src_name)
+ *     C function: sqlc_handle_t sqlc_backup_init(sqlc_handle_t dest_db, const char *  dest_name, sqlc_handle_t src_db, const char *  src_name);
+ */
+JNIEXPORT jlong JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1backup_1init__JLjava_lang_String_2JLjava_lang_String_2(JNIEnv *env, jclass _unused, jlong dest_db, jstring dest_name, jlong src_db, jstring src_name) {
+  const char* _strchars_dest_name = NULL;
+  const char* _strchars_src_name = NULL;
+  sqlc_handle_t _res;
+  if ( NULL != dest_name ) {
+    _strchars_dest_name = (*env)->GetStringUTFChars(env, dest_name, (jboolean*)NULL);
+  if ( NULL == _strchars_dest_name ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"dest_name\" in native dispatcher for \"sqlc_backup_init\"");
+      return 0;
+    }
+  }
+  if ( NULL != src_name ) {
+    _strchars_src_name = (*env)->GetStringUTFChars(env, src_name, (jboolean*)NULL);
+  if ( NULL == _strchars_src_name ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"src_name\" in native dispatcher for \"sqlc_backup_init\"");
+      return 0;
+    }
+  }
+  _res = sqlc_backup_init((sqlc_handle_t) dest_db, (char *) _strchars_dest_name, (sqlc_handle_t) src_db, (char *) _strchars_src_name);
+  if ( NULL != dest_name ) {
+    (*env)->ReleaseStringUTFChars(env, dest_name, _strchars_dest_name);
+  }
+  if ( NULL != src_name ) {
+    (*env)->ReleaseStringUTFChars(env, src_name, _strchars_src_name);
+  }
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_backup_pagecount(long backup)
+ *     C function: int sqlc_backup_pagecount(sqlc_handle_t backup);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1backup_1pagecount__J(JNIEnv *env, jclass _unused, jlong backup) {
+  int _res;
+  _res = sqlc_backup_pagecount((sqlc_handle_t) backup);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_backup_remaining(long backup)
+ *     C function: int sqlc_backup_remaining(sqlc_handle_t backup);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1backup_1remaining__J(JNIEnv *env, jclass _unused, jlong backup) {
+  int _res;
+  _res = sqlc_backup_remaining((sqlc_handle_t) backup);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_backup_step(long backup, int pages)
+ *     C function: int sqlc_backup_step(sqlc_handle_t backup, int pages);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1backup_1step__JI(JNIEnv *env, jclass _unused, jlong backup, jint pages) {
+  int _res;
+  _res = sqlc_backup_step((sqlc_handle_t) backup, (int) pages);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_blob_bytes(long blob)
+ *     C function: int sqlc_blob_bytes(sqlc_handle_t blob);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1blob_1bytes__J(JNIEnv *env, jclass _unused, jlong blob) {
+  int _res;
+  _res = sqlc_blob_bytes((sqlc_handle_t) blob);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_blob_close(long blob)
+ *     C function: int sqlc_blob_close(sqlc_handle_t blob);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1blob_1close__J(JNIEnv *env, jclass _unused, jlong blob) {
+  int _res;
+  _res = sqlc_blob_close((sqlc_handle_t) blob);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: long sqlc_blob_open(long db, java.lang.String db_name, java.lang.String table, java.lang.String column, long row, int flags)
+ *     C function: sqlc_handle_t sqlc_blob_open(sqlc_handle_t db, const char *  db_name, const char *  table, const char *  column, sqlc_long_t row, int flags);
+ */
+JNIEXPORT jlong JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1blob_1open__JLjava_lang_String_2Ljava_lang_String_2Ljava_lang_String_2JI(JNIEnv *env, jclass _unused, jlong db, jstring db_name, jstring table, jstring column, jlong row, jint flags) {
+  const char* _strchars_db_name = NULL;
+  const char* _strchars_table = NULL;
+  const char* _strchars_column = NULL;
+  sqlc_handle_t _res;
+  if ( NULL != db_name ) {
+    _strchars_db_name = (*env)->GetStringUTFChars(env, db_name, (jboolean*)NULL);
+  if ( NULL == _strchars_db_name ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"db_name\" in native dispatcher for \"sqlc_blob_open\"");
+      return 0;
+    }
+  }
+  if ( NULL != table ) {
+    _strchars_table = (*env)->GetStringUTFChars(env, table, (jboolean*)NULL);
+  if ( NULL == _strchars_table ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"table\" in native dispatcher for \"sqlc_blob_open\"");
+      return 0;
+    }
+  }
+  if ( NULL != column ) {
+    _strchars_column = (*env)->GetStringUTFChars(env, column, (jboolean*)NULL);
+  if ( NULL == _strchars_column ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"column\" in native dispatcher for \"sqlc_blob_open\"");
+      return 0;
+    }
+  }
+  _res = sqlc_blob_open((sqlc_handle_t) db, (char *) _strchars_db_name, (char *) _strchars_table, (char *) _strchars_column, (sqlc_long_t) row, (int) flags);
+  if ( NULL != db_name ) {
+    (*env)->ReleaseStringUTFChars(env, db_name, _strchars_db_name);
+  }
+  if ( NULL != table ) {
+    (*env)->ReleaseStringUTFChars(env, table, _strchars_table);
+  }
+  if ( NULL != column ) {
+    (*env)->ReleaseStringUTFChars(env, column, _strchars_column);
+  }
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_blob_read0(long blob, java.lang.Object buf, int buf_byte_offset, int n, int offset)
+ *     C function: int sqlc_blob_read(sqlc_handle_t blob, void *  buf, int n, int offset);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1blob_1read0__JLjava_lang_Object_2III(JNIEnv *env, jclass _unused, jlong blob, jobject buf, jint buf_byte_offset, jint n, jint offset) {
+  void * _buf_ptr = NULL;
+  int _res;
+  if ( NULL != buf ) {
+    _buf_ptr = (void *) (((char*) (*env)->GetDirectBufferAddress(env, buf)) + buf_byte_offset);
+  }
+  _res = sqlc_blob_read((sqlc_handle_t) blob, (void *) _buf_ptr, (int) n, (int) offset);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_blob_reopen(long blob, long row)
+ *     C function: int sqlc_blob_reopen(sqlc_handle_t blob, sqlc_long_t row);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1blob_1reopen__JJ(JNIEnv *env, jclass _unused, jlong blob, jlong row) {
+  int _res;
+  _res = sqlc_blob_reopen((sqlc_handle_t) blob, (sqlc_long_t) row);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_blob_write0(long blob, java.lang.Object buf, int buf_byte_offset, int n, int offset)
+ *     C function: int sqlc_blob_write(sqlc_handle_t blob, const void *  buf, int n, int offset);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1blob_1write0__JLjava_lang_Object_2III(JNIEnv *env, jclass _unused, jlong blob, jobject buf, jint buf_byte_offset, jint n, jint offset) {
+  void * _buf_ptr = NULL;
+  int _res;
+  if ( NULL != buf ) {
+    _buf_ptr = (void *) (((char*) (*env)->GetDirectBufferAddress(env, buf)) + buf_byte_offset);
+  }
+  _res = sqlc_blob_write((sqlc_handle_t) blob, (void *) _buf_ptr, (int) n, (int) offset);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_busy_profile_stats0(long busy, java.lang.Object buf, int buf_byte_offset, int len, int reset)
+ *     C function: int sqlc_busy_profile_stats(sqlc_handle_t busy, void *  buf, int len, int reset);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1busy_1profile_1stats0__JLjava_lang_Object_2III(JNIEnv *env, jclass _unused, jlong busy, jobject buf, jint buf_byte_offset, jint len, jint reset) {
+  void * _buf_ptr = NULL;
+  int _res;
+  if ( NULL != buf ) {
+    _buf_ptr = (void *) (((char*) (*env)->GetDirectBufferAddress(env, buf)) + buf_byte_offset);
+  }
+  _res = sqlc_busy_profile_stats((sqlc_handle_t) busy, (void *) _buf_ptr, (int) len, (int) reset);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_busy_profile_stop(long busy)
+ *     C function: int sqlc_busy_profile_stop(sqlc_handle_t busy);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1busy_1profile_1stop__J(JNIEnv *env, jclass _unused, jlong busy) {
+  int _res;
+  _res = sqlc_busy_profile_stop((sqlc_handle_t) busy);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_changes_drain0(long changes, java.lang.Object buf, int buf_byte_offset, int len)
+ *     C function: int sqlc_changes_drain(sqlc_handle_t changes, void *  buf, int len);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1changes_1drain0__JLjava_lang_Object_2II(JNIEnv *env, jclass _unused, jlong changes, jobject buf, jint buf_byte_offset, jint len) {
+  void * _buf_ptr = NULL;
+  int _res;
+  if ( NULL != buf ) {
+    _buf_ptr = (void *) (((char*) (*env)->GetDirectBufferAddress(env, buf)) + buf_byte_offset);
+  }
+  _res = sqlc_changes_drain((sqlc_handle_t) changes, (void *) _buf_ptr, (int) len);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: long sqlc_changes_dropped(long changes)
+ *     C function: sqlc_long_t sqlc_changes_dropped(sqlc_handle_t changes);
+ */
+JNIEXPORT jlong JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1changes_1dropped__J(JNIEnv *env, jclass _unused, jlong changes) {
+  sqlc_long_t _res;
+  _res = sqlc_changes_dropped((sqlc_handle_t) changes);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_changes_stop(long changes)
+ *     C function: int sqlc_changes_stop(sqlc_handle_t changes);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1changes_1stop__J(JNIEnv *env, jclass _unused, jlong changes) {
+  int _res;
+  _res = sqlc_changes_stop((sqlc_handle_t) changes);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: java.lang.String sqlc_changes_table_name(long changes, int id)
+ *     C function: const char *  sqlc_changes_table_name(sqlc_handle_t changes, int id);
+ */
+JNIEXPORT jstring JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1changes_1table_1name__JI(JNIEnv *env, jclass _unused, jlong changes, jint id) {
+  const char *  _res;
+  _res = sqlc_changes_table_name((sqlc_handle_t) changes, (int) id);
+  if (NULL == _res) return NULL;
+  return (*env)->NewStringUTF(env, _res);
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: long sqlc_db_busy_profile_start(long db, int timeout_ms)
+ *     C function: sqlc_handle_t sqlc_db_busy_profile_start(sqlc_handle_t db, int timeout_ms);
+ */
+JNIEXPORT jlong JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1busy_1profile_1start__JI(JNIEnv *env, jclass _unused, jlong db, jint timeout_ms) {
+  sqlc_handle_t _res;
+  _res = sqlc_db_busy_profile_start((sqlc_handle_t) db, (int) timeout_ms);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: long sqlc_db_changes_start(long db, int capacity)
+ *     C function: sqlc_handle_t sqlc_db_changes_start(sqlc_handle_t db, int capacity);
+ */
+JNIEXPORT jlong JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1changes_1start__JI(JNIEnv *env, jclass _unused, jlong db, jint capacity) {
+  sqlc_handle_t _res;
+  _res = sqlc_db_changes_start((sqlc_handle_t) db, (int) capacity);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_db_changeset_apply0(long db, java.lang.Object buf, int buf_byte_offset, int len, int policy, java.lang.Object stats, int stats_byte_offset, int slen)
+ *     C function: int sqlc_db_changeset_apply(sqlc_handle_t db, const void *  buf, int len, int policy, void *  stats, int slen);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1changeset_1apply0__JLjava_lang_Object_2IIILjava_lang_Object_2II(JNIEnv *env, jclass _unused, jlong db, jobject buf, jint buf_byte_offset, jint len, jint policy, jobject stats, jint stats_byte_offset, jint slen) {
+  void * _buf_ptr = NULL;
+  void * _stats_ptr = NULL;
+  int _res;
+  if ( NULL != buf ) {
+    _buf_ptr = (void *) (((char*) (*env)->GetDirectBufferAddress(env, buf)) + buf_byte_offset);
+  }
+  if ( NULL != stats ) {
+    _stats_ptr = (void *) (((char*) (*env)->GetDirectBufferAddress(env, stats)) + stats_byte_offset);
+  }
+  _res = sqlc_db_changeset_apply((sqlc_handle_t) db, (void *) _buf_ptr, (int) len, (int) policy, (void *) _stats_ptr, (int) slen);
+  return _res;
+}
+
+
 /*   Java->C glue code:
  *   Java package: io.liteglue.SQLiteNative
  *    Java method: int sqlc_db_close(long db)
  *     C function: int sqlc_db_close(sqlc_handle_t db);
  */
 JNIEXPORT jint JNICALL 
-Java_io_liteglue_SQLiteNative_sqlc_1db_1close__J(JNIEnv *env, jclass _unused, jlong db) {
+Java_io_liteglue_SQLiteNative_sqlc_1db_1close__J(JNIEnv *env, jclass _unused, jlong db) {
+  int _res;
+  _res = sqlc_db_close((sqlc_handle_t) db);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_db_deserialize0(long db, java.lang.String schema, java.lang.Object buf, int buf_byte_offset, long size, int flags)
+ *     C function: int sqlc_db_deserialize(sqlc_handle_t db, const char *  schema, void *  buf, sqlc_long_t size, int flags);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1deserialize0__JLjava_lang_String_2Ljava_lang_Object_2IJI(JNIEnv *env, jclass _unused, jlong db, jstring schema, jobject buf, jint buf_byte_offset, jlong size, jint flags) {
+  const char* _strchars_schema = NULL;
+  void * _buf_ptr = NULL;
+  int _res;
+  if ( NULL != schema ) {
+    _strchars_schema = (*env)->GetStringUTFChars(env, schema, (jboolean*)NULL);
+  if ( NULL == _strchars_schema ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"schema\" in native dispatcher for \"sqlc_db_deserialize\"");
+      return 0;
+    }
+  }
+  if ( NULL != buf ) {
+    _buf_ptr = (void *) (((char*) (*env)->GetDirectBufferAddress(env, buf)) + buf_byte_offset);
+  }
+  _res = sqlc_db_deserialize((sqlc_handle_t) db, (char *) _strchars_schema, (void *) _buf_ptr, (sqlc_long_t) size, (int) flags);
+  if ( NULL != schema ) {
+    (*env)->ReleaseStringUTFChars(env, schema, _strchars_schema);
+  }
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_db_deserialize_file(long db, java.lang.String schema, java.lang.String path, long offset, long size, int flags)
+ *     C function: int sqlc_db_deserialize_file(sqlc_handle_t db, const char *  schema, const char *  path, sqlc_long_t offset, sqlc_long_t size, int flags);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1deserialize_1file__JLjava_lang_String_2Ljava_lang_String_2JJI(JNIEnv *env, jclass _unused, jlong db, jstring schema, jstring path, jlong offset, jlong size, jint flags) {
+  const char* _strchars_schema = NULL;
+  const char* _strchars_path = NULL;
+  int _res;
+  if ( NULL != schema ) {
+    _strchars_schema = (*env)->GetStringUTFChars(env, schema, (jboolean*)NULL);
+  if ( NULL == _strchars_schema ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"schema\" in native dispatcher for \"sqlc_db_deserialize_file\"");
+      return 0;
+    }
+  }
+  if ( NULL != path ) {
+    _strchars_path = (*env)->GetStringUTFChars(env, path, (jboolean*)NULL);
+  if ( NULL == _strchars_path ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"path\" in native dispatcher for \"sqlc_db_deserialize_file\"");
+      return 0;
+    }
+  }
+  _res = sqlc_db_deserialize_file((sqlc_handle_t) db, (char *) _strchars_schema, (char *) _strchars_path, (sqlc_long_t) offset, (sqlc_long_t) size, (int) flags);
+  if ( NULL != schema ) {
+    (*env)->ReleaseStringUTFChars(env, schema, _strchars_schema);
+  }
+  if ( NULL != path ) {
+    (*env)->ReleaseStringUTFChars(env, path, _strchars_path);
+  }
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_db_errcode(long db)
+ *     C function: int sqlc_db_errcode(sqlc_handle_t db);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1errcode__J(JNIEnv *env, jclass _unused, jlong db) {
+  int _res;
+  _res = sqlc_db_errcode((sqlc_handle_t) db);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: java.lang.String sqlc_db_errmsg_native(long db)
+ *     C function: const char *  sqlc_db_errmsg_native(sqlc_handle_t db);
+ */
+JNIEXPORT jstring JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1errmsg_1native__J(JNIEnv *env, jclass _unused, jlong db) {
+  const char *  _res;
+  _res = sqlc_db_errmsg_native((sqlc_handle_t) db);
+  if (NULL == _res) return NULL;
+  return (*env)->NewStringUTF(env, _res);
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_db_export0(long db, java.lang.String sql, java.lang.String params, java.lang.String path, int format, java.lang.Object stats, int stats_byte_offset, int len)
+ *     C function: int sqlc_db_export(sqlc_handle_t db, const char *  sql, const char *  params, const char *  path, int format, void *  stats, int len);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1export0__JLjava_lang_String_2Ljava_lang_String_2Ljava_lang_String_2ILjava_lang_Object_2II(JNIEnv *env, jclass _unused, jlong db, jstring sql, jstring params, jstring path, jint format, jobject stats, jint stats_byte_offset, jint len) {
+  const char* _strchars_sql = NULL;
+  const char* _strchars_params = NULL;
+  const char* _strchars_path = NULL;
+  void * _stats_ptr = NULL;
+  int _res;
+  if ( NULL != sql ) {
+    _strchars_sql = (*env)->GetStringUTFChars(env, sql, (jboolean*)NULL);
+  if ( NULL == _strchars_sql ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"sql\" in native dispatcher for \"sqlc_db_export\"");
+      return 0;
+    }
+  }
+  if ( NULL != params ) {
+    _strchars_params = (*env)->GetStringUTFChars(env, params, (jboolean*)NULL);
+  if ( NULL == _strchars_params ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"params\" in native dispatcher for \"sqlc_db_export\"");
+      return 0;
+    }
+  }
+  if ( NULL != path ) {
+    _strchars_path = (*env)->GetStringUTFChars(env, path, (jboolean*)NULL);
+  if ( NULL == _strchars_path ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"path\" in native dispatcher for \"sqlc_db_export\"");
+      return 0;
+    }
+  }
+  if ( NULL != stats ) {
+    _stats_ptr = (void *) (((char*) (*env)->GetDirectBufferAddress(env, stats)) + stats_byte_offset);
+  }
+  _res = sqlc_db_export((sqlc_handle_t) db, (char *) _strchars_sql, (char *) _strchars_params, (char *) _strchars_path, (int) format, (void *) _stats_ptr, (int) len);
+  if ( NULL != sql ) {
+    (*env)->ReleaseStringUTFChars(env, sql, _strchars_sql);
+  }
+  if ( NULL != params ) {
+    (*env)->ReleaseStringUTFChars(env, params, _strchars_params);
+  }
+  if ( NULL != path ) {
+    (*env)->ReleaseStringUTFChars(env, path, _strchars_path);
+  }
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_db_import0(long db, java.lang.String path, int format, java.lang.String sql, int chunk_rows, java.lang.Object stats, int stats_byte_offset, int len)
+ *     C function: int sqlc_db_import(sqlc_handle_t db, const char *  path, int format, const char *  sql, int chunk_rows, void *  stats, int len);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1import0__JLjava_lang_String_2ILjava_lang_String_2ILjava_lang_Object_2II(JNIEnv *env, jclass _unused, jlong db, jstring path, jint format, jstring sql, jint chunk_rows, jobject stats, jint stats_byte_offset, jint len) {
+  const char* _strchars_path = NULL;
+  const char* _strchars_sql = NULL;
+  void * _stats_ptr = NULL;
+  int _res;
+  if ( NULL != path ) {
+    _strchars_path = (*env)->GetStringUTFChars(env, path, (jboolean*)NULL);
+  if ( NULL == _strchars_path ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"path\" in native dispatcher for \"sqlc_db_import\"");
+      return 0;
+    }
+  }
+  if ( NULL != sql ) {
+    _strchars_sql = (*env)->GetStringUTFChars(env, sql, (jboolean*)NULL);
+  if ( NULL == _strchars_sql ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"sql\" in native dispatcher for \"sqlc_db_import\"");
+      return 0;
+    }
+  }
+  if ( NULL != stats ) {
+    _stats_ptr = (void *) (((char*) (*env)->GetDirectBufferAddress(env, stats)) + stats_byte_offset);
+  }
+  _res = sqlc_db_import((sqlc_handle_t) db, (char *) _strchars_path, (int) format, (char *) _strchars_sql, (int) chunk_rows, (void *) _stats_ptr, (int) len);
+  if ( NULL != path ) {
+    (*env)->ReleaseStringUTFChars(env, path, _strchars_path);
+  }
+  if ( NULL != sql ) {
+    (*env)->ReleaseStringUTFChars(env, sql, _strchars_sql);
+  }
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: void sqlc_db_interrupt(long db)
+ *     C function: void sqlc_db_interrupt(sqlc_handle_t db);
+ */
+JNIEXPORT void JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1interrupt__J(JNIEnv *env, jclass _unused, jlong db) {
+  sqlc_db_interrupt((sqlc_handle_t) db);
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_db_key_native_string(long db, java.lang.String key_string)
+ *     C function: int sqlc_db_key_native_string(sqlc_handle_t db, char *  key_string);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1key_1native_1string__JLjava_lang_String_2(JNIEnv *env, jclass _unused, jlong db, jstring key_string) {
+  const char* _strchars_key_string = NULL;
+  int _res;
+  if ( NULL != key_string ) {
+    _strchars_key_string = (*env)->GetStringUTFChars(env, key_string, (jboolean*)NULL);
+  if ( NULL == _strchars_key_string ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"key_string\" in native dispatcher for \"sqlc_db_key_native_string\"");
+      return 0;
+    }
+  }
+  _res = sqlc_db_key_native_string((sqlc_handle_t) db, (char *) _strchars_key_string);
+  if ( NULL != key_string ) {
+    (*env)->ReleaseStringUTFChars(env, key_string, _strchars_key_string);
+  }
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: long sqlc_db_last_insert_rowid(long db)
+ *     C function: sqlc_long_t sqlc_db_last_insert_rowid(sqlc_handle_t db);
+ */
+JNIEXPORT jlong JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1last_1insert_1rowid__J(JNIEnv *env, jclass _unused, jlong db) {
+  sqlc_long_t _res;
+  _res = sqlc_db_last_insert_rowid((sqlc_handle_t) db);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_db_maintain0(long db, int budget_ms, int flags, java.lang.Object stats, int stats_byte_offset, int len)
+ *     C function: int sqlc_db_maintain(sqlc_handle_t db, int budget_ms, int flags, void *  stats, int len);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1maintain0__JIILjava_lang_Object_2II(JNIEnv *env, jclass _unused, jlong db, jint budget_ms, jint flags, jobject stats, jint stats_byte_offset, jint len) {
+  void * _stats_ptr = NULL;
+  int _res;
+  if ( NULL != stats ) {
+    _stats_ptr = (void *) (((char*) (*env)->GetDirectBufferAddress(env, stats)) + stats_byte_offset);
+  }
+  _res = sqlc_db_maintain((sqlc_handle_t) db, (int) budget_ms, (int) flags, (void *) _stats_ptr, (int) len);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: long sqlc_db_new_fj(long db)
+ *     C function: sqlc_handle_t sqlc_db_new_fj(sqlc_handle_t db);
+ */
+JNIEXPORT jlong JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1new_1fj__J(JNIEnv *env, jclass _unused, jlong db) {
+  sqlc_handle_t _res;
+  _res = sqlc_db_new_fj((sqlc_handle_t) db);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: long sqlc_db_open(java.lang.String filename, int flags)
+ *     C function: sqlc_handle_t sqlc_db_open(const char *  filename, int flags);
+ */
+JNIEXPORT jlong JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1open__Ljava_lang_String_2I(JNIEnv *env, jclass _unused, jstring filename, jint flags) {
+  const char* _strchars_filename = NULL;
+  sqlc_handle_t _res;
+  if ( NULL != filename ) {
+    _strchars_filename = (*env)->GetStringUTFChars(env, filename, (jboolean*)NULL);
+  if ( NULL == _strchars_filename ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"filename\" in native dispatcher for \"sqlc_db_open\"");
+      return 0;
+    }
+  }
+  _res = sqlc_db_open((char *) _strchars_filename, (int) flags);
+  if ( NULL != filename ) {
+    (*env)->ReleaseStringUTFChars(env, filename, _strchars_filename);
+  }
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: long sqlc_db_open_vfs(java.lang.String filename, int flags, java.lang.String vfs)
+ *     C function: sqlc_handle_t sqlc_db_open_vfs(const char *  filename, int flags, const char *  vfs);
+ */
+JNIEXPORT jlong JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1open_1vfs__Ljava_lang_String_2ILjava_lang_String_2(JNIEnv *env, jclass _unused, jstring filename, jint flags, jstring vfs) {
+  const char* _strchars_filename = NULL;
+  const char* _strchars_vfs = NULL;
+  sqlc_handle_t _res;
+  if ( NULL != filename ) {
+    _strchars_filename = (*env)->GetStringUTFChars(env, filename, (jboolean*)NULL);
+  if ( NULL == _strchars_filename ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"filename\" in native dispatcher for \"sqlc_db_open_vfs\"");
+      return 0;
+    }
+  }
+  if ( NULL != vfs ) {
+    _strchars_vfs = (*env)->GetStringUTFChars(env, vfs, (jboolean*)NULL);
+  if ( NULL == _strchars_vfs ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"vfs\" in native dispatcher for \"sqlc_db_open_vfs\"");
+      return 0;
+    }
+  }
+  _res = sqlc_db_open_vfs((char *) _strchars_filename, (int) flags, (char *) _strchars_vfs);
+  if ( NULL != filename ) {
+    (*env)->ReleaseStringUTFChars(env, filename, _strchars_filename);
+  }
+  if ( NULL != vfs ) {
+    (*env)->ReleaseStringUTFChars(env, vfs, _strchars_vfs);
+  }
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: long sqlc_db_prepare_st(long db, java.lang.String sql)
+ *     C function: sqlc_handle_t sqlc_db_prepare_st(sqlc_handle_t db, const char *  sql);
+ */
+JNIEXPORT jlong JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1prepare_1st__JLjava_lang_String_2(JNIEnv *env, jclass _unused, jlong db, jstring sql) {
+  const char* _strchars_sql = NULL;
+  sqlc_handle_t _res;
+  if ( NULL != sql ) {
+    _strchars_sql = (*env)->GetStringUTFChars(env, sql, (jboolean*)NULL);
+  if ( NULL == _strchars_sql ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"sql\" in native dispatcher for \"sqlc_db_prepare_st\"");
+      return 0;
+    }
+  }
+  _res = sqlc_db_prepare_st((sqlc_handle_t) db, (char *) _strchars_sql);
+  if ( NULL != sql ) {
+    (*env)->ReleaseStringUTFChars(env, sql, _strchars_sql);
+  }
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_db_register_functions(long db, int mask)
+ *     C function: int sqlc_db_register_functions(sqlc_handle_t db, int mask);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1register_1functions__JI(JNIEnv *env, jclass _unused, jlong db, jint mask) {
+  int _res;
+  _res = sqlc_db_register_functions((sqlc_handle_t) db, (int) mask);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: long sqlc_db_release_memory(long db)
+ *     C function: sqlc_long_t sqlc_db_release_memory(sqlc_handle_t db);
+ */
+JNIEXPORT jlong JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1release_1memory__J(JNIEnv *env, jclass _unused, jlong db) {
+  sqlc_long_t _res;
+  _res = sqlc_db_release_memory((sqlc_handle_t) db);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: long sqlc_db_serialize0(long db, java.lang.String schema, java.lang.Object buf, int buf_byte_offset, long len)
+ *     C function: sqlc_long_t sqlc_db_serialize(sqlc_handle_t db, const char *  schema, void *  buf, sqlc_long_t len);
+ */
+JNIEXPORT jlong JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1serialize0__JLjava_lang_String_2Ljava_lang_Object_2IJ(JNIEnv *env, jclass _unused, jlong db, jstring schema, jobject buf, jint buf_byte_offset, jlong len) {
+  const char* _strchars_schema = NULL;
+  void * _buf_ptr = NULL;
+  sqlc_long_t _res;
+  if ( NULL != schema ) {
+    _strchars_schema = (*env)->GetStringUTFChars(env, schema, (jboolean*)NULL);
+  if ( NULL == _strchars_schema ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"schema\" in native dispatcher for \"sqlc_db_serialize\"");
+      return 0;
+    }
+  }
+  if ( NULL != buf ) {
+    _buf_ptr = (void *) (((char*) (*env)->GetDirectBufferAddress(env, buf)) + buf_byte_offset);
+  }
+  _res = sqlc_db_serialize((sqlc_handle_t) db, (char *) _strchars_schema, (void *) _buf_ptr, (sqlc_long_t) len);
+  if ( NULL != schema ) {
+    (*env)->ReleaseStringUTFChars(env, schema, _strchars_schema);
+  }
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: long sqlc_db_session_new(long db, java.lang.String schema)
+ *     C function: sqlc_handle_t sqlc_db_session_new(sqlc_handle_t db, const char *  schema);
+ */
+JNIEXPORT jlong JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1session_1new__JLjava_lang_String_2(JNIEnv *env, jclass _unused, jlong db, jstring schema) {
+  const char* _strchars_schema = NULL;
+  sqlc_handle_t _res;
+  if ( NULL != schema ) {
+    _strchars_schema = (*env)->GetStringUTFChars(env, schema, (jboolean*)NULL);
+  if ( NULL == _strchars_schema ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"schema\" in native dispatcher for \"sqlc_db_session_new\"");
+      return 0;
+    }
+  }
+  _res = sqlc_db_session_new((sqlc_handle_t) db, (char *) _strchars_schema);
+  if ( NULL != schema ) {
+    (*env)->ReleaseStringUTFChars(env, schema, _strchars_schema);
+  }
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_db_stats0(long db, java.lang.Object buf, int buf_byte_offset, int len, int reset)
+ *     C function: int sqlc_db_stats(sqlc_handle_t db, void *  buf, int len, int reset);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1stats0__JLjava_lang_Object_2III(JNIEnv *env, jclass _unused, jlong db, jobject buf, jint buf_byte_offset, jint len, jint reset) {
+  void * _buf_ptr = NULL;
+  int _res;
+  if ( NULL != buf ) {
+    _buf_ptr = (void *) (((char*) (*env)->GetDirectBufferAddress(env, buf)) + buf_byte_offset);
+  }
+  _res = sqlc_db_stats((sqlc_handle_t) db, (void *) _buf_ptr, (int) len, (int) reset);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_db_temp_store(long db, int mode, long spill_bytes)
+ *     C function: int sqlc_db_temp_store(sqlc_handle_t db, int mode, sqlc_long_t spill_bytes);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1temp_1store__JIJ(JNIEnv *env, jclass _unused, jlong db, jint mode, jlong spill_bytes) {
+  int _res;
+  _res = sqlc_db_temp_store((sqlc_handle_t) db, (int) mode, (sqlc_long_t) spill_bytes);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_db_total_changes(long db)
+ *     C function: int sqlc_db_total_changes(sqlc_handle_t db);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1total_1changes__J(JNIEnv *env, jclass _unused, jlong db) {
+  int _res;
+  _res = sqlc_db_total_changes((sqlc_handle_t) db);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: long sqlc_db_total_changes64(long db)
+ *     C function: sqlc_long_t sqlc_db_total_changes64(sqlc_handle_t db);
+ */
+JNIEXPORT jlong JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1total_1changes64__J(JNIEnv *env, jclass _unused, jlong db) {
+  sqlc_long_t _res;
+  _res = sqlc_db_total_changes64((sqlc_handle_t) db);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: long sqlc_db_trace_start(long db, int mask, int capacity)
+ *     C function: sqlc_handle_t sqlc_db_trace_start(sqlc_handle_t db, int mask, int capacity);
+ */
+JNIEXPORT jlong JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1trace_1start__JII(JNIEnv *env, jclass _unused, jlong db, jint mask, jint capacity) {
+  sqlc_handle_t _res;
+  _res = sqlc_db_trace_start((sqlc_handle_t) db, (int) mask, (int) capacity);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_db_warmup0(long db, java.lang.String names, long max_bytes, java.lang.Object stats, int stats_byte_offset, int len)
+ *     C function: int sqlc_db_warmup(sqlc_handle_t db, const char *  names, sqlc_long_t max_bytes, void *  stats, int len);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1db_1warmup0__JLjava_lang_String_2JLjava_lang_Object_2II(JNIEnv *env, jclass _unused, jlong db, jstring names, jlong max_bytes, jobject stats, jint stats_byte_offset, jint len) {
+  const char* _strchars_names = NULL;
+  void * _stats_ptr = NULL;
+  int _res;
+  if ( NULL != names ) {
+    _strchars_names = (*env)->GetStringUTFChars(env, names, (jboolean*)NULL);
+  if ( NULL == _strchars_names ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"names\" in native dispatcher for \"sqlc_db_warmup\"");
+      return 0;
+    }
+  }
+  if ( NULL != stats ) {
+    _stats_ptr = (void *) (((char*) (*env)->GetDirectBufferAddress(env, stats)) + stats_byte_offset);
+  }
+  _res = sqlc_db_warmup((sqlc_handle_t) db, (char *) _strchars_names, (sqlc_long_t) max_bytes, (void *) _stats_ptr, (int) len);
+  if ( NULL != names ) {
+    (*env)->ReleaseStringUTFChars(env, names, _strchars_names);
+  }
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: java.lang.String sqlc_errstr_native(int errcode)
+ *     C function: const char *  sqlc_errstr_native(int errcode);
+ */
+JNIEXPORT jstring JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1errstr_1native__I(JNIEnv *env, jclass _unused, jint errcode) {
+  const char *  _res;
+  _res = sqlc_errstr_native((int) errcode);
+  if (NULL == _res) return NULL;
+  return (*env)->NewStringUTF(env, _res);
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_fj_alloc_stats0(long fj, java.lang.Object buf, int buf_byte_offset, int len)
+ *     C function: int sqlc_fj_alloc_stats(sqlc_handle_t fj, void *  buf, int len);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1fj_1alloc_1stats0__JLjava_lang_Object_2II(JNIEnv *env, jclass _unused, jlong fj, jobject buf, jint buf_byte_offset, jint len) {
+  void * _buf_ptr = NULL;
+  int _res;
+  if ( NULL != buf ) {
+    _buf_ptr = (void *) (((char*) (*env)->GetDirectBufferAddress(env, buf)) + buf_byte_offset);
+  }
+  _res = sqlc_fj_alloc_stats((sqlc_handle_t) fj, (void *) _buf_ptr, (int) len);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: void sqlc_fj_dispose(long fj)
+ *     C function: void sqlc_fj_dispose(sqlc_handle_t fj);
+ */
+JNIEXPORT void JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1fj_1dispose__J(JNIEnv *env, jclass _unused, jlong fj) {
+  sqlc_fj_dispose((sqlc_handle_t) fj);
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_fj_register_sql(long fj, java.lang.String sql)
+ *     C function: int sqlc_fj_register_sql(sqlc_handle_t fj, const char *  sql);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1fj_1register_1sql__JLjava_lang_String_2(JNIEnv *env, jclass _unused, jlong fj, jstring sql) {
+  const char* _strchars_sql = NULL;
+  int _res;
+  if ( NULL != sql ) {
+    _strchars_sql = (*env)->GetStringUTFChars(env, sql, (jboolean*)NULL);
+  if ( NULL == _strchars_sql ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"sql\" in native dispatcher for \"sqlc_fj_register_sql\"");
+      return 0;
+    }
+  }
+  _res = sqlc_fj_register_sql((sqlc_handle_t) fj, (char *) _strchars_sql);
+  if ( NULL != sql ) {
+    (*env)->ReleaseStringUTFChars(env, sql, _strchars_sql);
+  }
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: java.lang.String sqlc_fj_run(long fj, java.lang.String batch_json, int ll)
+ *     C function: const char *  sqlc_fj_run(sqlc_handle_t fj, const char *  batch_json, int ll);
+ */
+JNIEXPORT jstring JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1fj_1run__JLjava_lang_String_2I(JNIEnv *env, jclass _unused, jlong fj, jstring batch_json, jint ll) {
+  const char* _strchars_batch_json = NULL;
+  const char *  _res;
+  if ( NULL != batch_json ) {
+    _strchars_batch_json = (*env)->GetStringUTFChars(env, batch_json, (jboolean*)NULL);
+  if ( NULL == _strchars_batch_json ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"batch_json\" in native dispatcher for \"sqlc_fj_run\"");
+      return 0;
+    }
+  }
+  _res = sqlc_fj_run((sqlc_handle_t) fj, (char *) _strchars_batch_json, (int) ll);
+  if ( NULL != batch_json ) {
+    (*env)->ReleaseStringUTFChars(env, batch_json, _strchars_batch_json);
+  }
+  if (NULL == _res) return NULL;
+  return (*env)->NewStringUTF(env, _res);
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_fj_set_budget(long fj, int ms, long vm_steps)
+ *     C function: int sqlc_fj_set_budget(sqlc_handle_t fj, int ms, sqlc_long_t vm_steps);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1fj_1set_1budget__JIJ(JNIEnv *env, jclass _unused, jlong fj, jint ms, jlong vm_steps) {
   int _res;
-  _res = sqlc_db_close((sqlc_handle_t) db);
+  _res = sqlc_fj_set_budget((sqlc_handle_t) fj, (int) ms, (sqlc_long_t) vm_steps);
   return _res;
 }
 
 
 /*   Java->C glue code:
  *   Java package: io.liteglue.SQLiteNative
- *    Java method: int sqlc_db_errcode(long db)
- *     C function: int sqlc_db_errcode(sqlc_handle_t db);
+ *    Java method: int sqlc_fj_set_cache(long fj, int max_bytes)
+ *     C function: int sqlc_fj_set_cache(sqlc_handle_t fj, int max_bytes);
  */
 JNIEXPORT jint JNICALL 
-Java_io_liteglue_SQLiteNative_sqlc_1db_1errcode__J(JNIEnv *env, jclass _unused, jlong db) {
+Java_io_liteglue_SQLiteNative_sqlc_1fj_1set_1cache__JI(JNIEnv *env, jclass _unused, jlong fj, jint max_bytes) {
   int _res;
-  _res = sqlc_db_errcode((sqlc_handle_t) db);
+  _res = sqlc_fj_set_cache((sqlc_handle_t) fj, (int) max_bytes);
   return _res;
 }
 
 
 /*   Java->C glue code:
  *   Java package: io.liteglue.SQLiteNative
- *    Java method: java.lang.String sqlc_db_errmsg_native(long db)
- *     C function: const char *  sqlc_db_errmsg_native(sqlc_handle_t db);
+ *    Java method: void sqlc_fj_set_pipeline(long fj, int enable)
+ *     C function: void sqlc_fj_set_pipeline(sqlc_handle_t fj, int enable);
  */
-JNIEXPORT jstring JNICALL 
-Java_io_liteglue_SQLiteNative_sqlc_1db_1errmsg_1native__J(JNIEnv *env, jclass _unused, jlong db) {
-  const char *  _res;
-  _res = sqlc_db_errmsg_native((sqlc_handle_t) db);
-  if (NULL == _res) return NULL;
-  return (*env)->NewStringUTF(env, _res);
+JNIEXPORT void JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1fj_1set_1pipeline__JI(JNIEnv *env, jclass _unused, jlong fj, jint enable) {
+  sqlc_fj_set_pipeline((sqlc_handle_t) fj, (int) enable);
 }
 
 
 /*   Java->C glue code:
  *   Java package: io.liteglue.SQLiteNative
- *    Java method: int sqlc_db_key_native_string(long db, java.lang.String key_string)
- *     C function: int sqlc_db_key_native_string(sqlc_handle_t db, char *  key_string);
+ *    Java method: long sqlc_hard_heap_limit(long n)
+ *     C function: sqlc_long_t sqlc_hard_heap_limit(sqlc_long_t n);
+ */
+JNIEXPORT jlong JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1hard_1heap_1limit__J(JNIEnv *env, jclass _unused, jlong n) {
+  sqlc_long_t _res;
+  _res = sqlc_hard_heap_limit((sqlc_long_t) n);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_memory_stats0(java.lang.Object buf, int buf_byte_offset, int len)
+ *     C function: int sqlc_memory_stats(void *  buf, int len);
  */
 JNIEXPORT jint JNICALL 
-Java_io_liteglue_SQLiteNative_sqlc_1db_1key_1native_1string__JLjava_lang_String_2(JNIEnv *env, jclass _unused, jlong db, jstring key_string) {
-  const char* _strchars_key_string = NULL;
+Java_io_liteglue_SQLiteNative_sqlc_1memory_1stats0__Ljava_lang_Object_2II(JNIEnv *env, jclass _unused, jobject buf, jint buf_byte_offset, jint len) {
+  void * _buf_ptr = NULL;
   int _res;
-  if ( NULL != key_string ) {
-    _strchars_key_string = (*env)->GetStringUTFChars(env, key_string, (jboolean*)NULL);
-  if ( NULL == _strchars_key_string ) {
+  if ( NULL != buf ) {
+    _buf_ptr = (void *) (((char*) (*env)->GetDirectBufferAddress(env, buf)) + buf_byte_offset);
+  }
+  _res = sqlc_memory_stats((void *) _buf_ptr, (int) len);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_multi_add(long multi, long fj, java.lang.String batch_json, int ll)
+ *     C function: int sqlc_multi_add(sqlc_handle_t multi, sqlc_handle_t fj, const char *  batch_json, int ll);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1multi_1add__JJLjava_lang_String_2I(JNIEnv *env, jclass _unused, jlong multi, jlong fj, jstring batch_json, jint ll) {
+  const char* _strchars_batch_json = NULL;
+  int _res;
+  if ( NULL != batch_json ) {
+    _strchars_batch_json = (*env)->GetStringUTFChars(env, batch_json, (jboolean*)NULL);
+  if ( NULL == _strchars_batch_json ) {
       (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
-                       "Failed to get UTF-8 chars for argument \"key_string\" in native dispatcher for \"sqlc_db_key_native_string\"");
+                       "Failed to get UTF-8 chars for argument \"batch_json\" in native dispatcher for \"sqlc_multi_add\"");
       return 0;
     }
   }
-  _res = sqlc_db_key_native_string((sqlc_handle_t) db, (char *) _strchars_key_string);
-  if ( NULL != key_string ) {
-    (*env)->ReleaseStringUTFChars(env, key_string, _strchars_key_string);
+  _res = sqlc_multi_add((sqlc_handle_t) multi, (sqlc_handle_t) fj, (char *) _strchars_batch_json, (int) ll);
+  if ( NULL != batch_json ) {
+    (*env)->ReleaseStringUTFChars(env, batch_json, _strchars_batch_json);
   }
   return _res;
 }
@@ -111,50 +1120,88 @@ Java_io_liteglue_SQLiteNative_sqlc_1db_1key_1native_1string__JLjava_lang_String_
 
 /*   Java->C glue code:
  *   Java package: io.liteglue.SQLiteNative
- *    Java method: long sqlc_db_last_insert_rowid(long db)
- *     C function: sqlc_long_t sqlc_db_last_insert_rowid(sqlc_handle_t db);
+ *    Java method: void sqlc_multi_dispose(long multi)
+ *     C function: void sqlc_multi_dispose(sqlc_handle_t multi);
  */
-JNIEXPORT jlong JNICALL 
-Java_io_liteglue_SQLiteNative_sqlc_1db_1last_1insert_1rowid__J(JNIEnv *env, jclass _unused, jlong db) {
-  sqlc_long_t _res;
-  _res = sqlc_db_last_insert_rowid((sqlc_handle_t) db);
-  return _res;
+JNIEXPORT void JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1multi_1dispose__J(JNIEnv *env, jclass _unused, jlong multi) {
+  sqlc_multi_dispose((sqlc_handle_t) multi);
 }
 
 
 /*   Java->C glue code:
  *   Java package: io.liteglue.SQLiteNative
- *    Java method: long sqlc_db_new_fj(long db)
- *     C function: sqlc_handle_t sqlc_db_new_fj(sqlc_handle_t db);
+ *    Java method: long sqlc_multi_new(int max_threads)
+ *     C function: sqlc_handle_t sqlc_multi_new(int max_threads);
  */
 JNIEXPORT jlong JNICALL 
-Java_io_liteglue_SQLiteNative_sqlc_1db_1new_1fj__J(JNIEnv *env, jclass _unused, jlong db) {
+Java_io_liteglue_SQLiteNative_sqlc_1multi_1new__I(JNIEnv *env, jclass _unused, jint max_threads) {
   sqlc_handle_t _res;
-  _res = sqlc_db_new_fj((sqlc_handle_t) db);
+  _res = sqlc_multi_new((int) max_threads);
   return _res;
 }
 
 
 /*   Java->C glue code:
  *   Java package: io.liteglue.SQLiteNative
- *    Java method: long sqlc_db_open(java.lang.String filename, int flags)
- *     C function: sqlc_handle_t sqlc_db_open(const char *  filename, int flags);
+ *    Java method: java.lang.String sqlc_multi_run(long multi)
+ *     C function: const char *  sqlc_multi_run(sqlc_handle_t multi);
+ */
+JNIEXPORT jstring JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1multi_1run__J(JNIEnv *env, jclass _unused, jlong multi) {
+  const char *  _res;
+  _res = sqlc_multi_run((sqlc_handle_t) multi);
+  if (NULL == _res) return NULL;
+  return (*env)->NewStringUTF(env, _res);
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_range_vfs_register()
+ *     C function: int sqlc_range_vfs_register();
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1range_1vfs_1register__(JNIEnv *env, jclass _unused) {
+  int _res;
+  _res = sqlc_range_vfs_register();
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: long sqlc_release_memory()
+ *     C function: sqlc_long_t sqlc_release_memory();
  */
 JNIEXPORT jlong JNICALL 
-Java_io_liteglue_SQLiteNative_sqlc_1db_1open__Ljava_lang_String_2I(JNIEnv *env, jclass _unused, jstring filename, jint flags) {
-  const char* _strchars_filename = NULL;
-  sqlc_handle_t _res;
-  if ( NULL != filename ) {
-    _strchars_filename = (*env)->GetStringUTFChars(env, filename, (jboolean*)NULL);
-  if ( NULL == _strchars_filename ) {
+Java_io_liteglue_SQLiteNative_sqlc_1release_1memory__(JNIEnv *env, jclass _unused) {
+  sqlc_long_t _res;
+  _res = sqlc_release_memory();
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_session_attach(long session, java.lang.String table)
+ *     C function: int sqlc_session_attach(sqlc_handle_t session, const char *  table);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1session_1attach__JLjava_lang_String_2(JNIEnv *env, jclass _unused, jlong session, jstring table) {
+  const char* _strchars_table = NULL;
+  int _res;
+  if ( NULL != table ) {
+    _strchars_table = (*env)->GetStringUTFChars(env, table, (jboolean*)NULL);
+  if ( NULL == _strchars_table ) {
       (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
-                       "Failed to get UTF-8 chars for argument \"filename\" in native dispatcher for \"sqlc_db_open\"");
+                       "Failed to get UTF-8 chars for argument \"table\" in native dispatcher for \"sqlc_session_attach\"");
       return 0;
     }
   }
-  _res = sqlc_db_open((char *) _strchars_filename, (int) flags);
-  if ( NULL != filename ) {
-    (*env)->ReleaseStringUTFChars(env, filename, _strchars_filename);
+  _res = sqlc_session_attach((sqlc_handle_t) session, (char *) _strchars_table);
+  if ( NULL != table ) {
+    (*env)->ReleaseStringUTFChars(env, table, _strchars_table);
   }
   return _res;
 }
@@ -162,90 +1209,74 @@ Java_io_liteglue_SQLiteNative_sqlc_1db_1open__Ljava_lang_String_2I(JNIEnv *env,
 
 /*   Java->C glue code:
  *   Java package: io.liteglue.SQLiteNative
- *    Java method: long sqlc_db_prepare_st(long db, java.lang.String sql)
- *     C function: sqlc_handle_t sqlc_db_prepare_st(sqlc_handle_t db, const char *  sql);
+ *    Java method: int sqlc_session_changeset0(long session, int patchset, java.lang.Object buf, int buf_byte_offset, int len)
+ *     C function: int sqlc_session_changeset(sqlc_handle_t session, int patchset, void *  buf, int len);
  */
-JNIEXPORT jlong JNICALL 
-Java_io_liteglue_SQLiteNative_sqlc_1db_1prepare_1st__JLjava_lang_String_2(JNIEnv *env, jclass _unused, jlong db, jstring sql) {
-  const char* _strchars_sql = NULL;
-  sqlc_handle_t _res;
-  if ( NULL != sql ) {
-    _strchars_sql = (*env)->GetStringUTFChars(env, sql, (jboolean*)NULL);
-  if ( NULL == _strchars_sql ) {
-      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
-                       "Failed to get UTF-8 chars for argument \"sql\" in native dispatcher for \"sqlc_db_prepare_st\"");
-      return 0;
-    }
-  }
-  _res = sqlc_db_prepare_st((sqlc_handle_t) db, (char *) _strchars_sql);
-  if ( NULL != sql ) {
-    (*env)->ReleaseStringUTFChars(env, sql, _strchars_sql);
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1session_1changeset0__JILjava_lang_Object_2II(JNIEnv *env, jclass _unused, jlong session, jint patchset, jobject buf, jint buf_byte_offset, jint len) {
+  void * _buf_ptr = NULL;
+  int _res;
+  if ( NULL != buf ) {
+    _buf_ptr = (void *) (((char*) (*env)->GetDirectBufferAddress(env, buf)) + buf_byte_offset);
   }
+  _res = sqlc_session_changeset((sqlc_handle_t) session, (int) patchset, (void *) _buf_ptr, (int) len);
   return _res;
 }
 
 
 /*   Java->C glue code:
  *   Java package: io.liteglue.SQLiteNative
- *    Java method: int sqlc_db_total_changes(long db)
- *     C function: int sqlc_db_total_changes(sqlc_handle_t db);
+ *    Java method: int sqlc_session_delete(long session)
+ *     C function: int sqlc_session_delete(sqlc_handle_t session);
  */
 JNIEXPORT jint JNICALL 
-Java_io_liteglue_SQLiteNative_sqlc_1db_1total_1changes__J(JNIEnv *env, jclass _unused, jlong db) {
+Java_io_liteglue_SQLiteNative_sqlc_1session_1delete__J(JNIEnv *env, jclass _unused, jlong session) {
   int _res;
-  _res = sqlc_db_total_changes((sqlc_handle_t) db);
+  _res = sqlc_session_delete((sqlc_handle_t) session);
   return _res;
 }
 
 
 /*   Java->C glue code:
  *   Java package: io.liteglue.SQLiteNative
- *    Java method: java.lang.String sqlc_errstr_native(int errcode)
- *     C function: const char *  sqlc_errstr_native(int errcode);
+ *    Java method: int sqlc_session_enable(long session, int enable)
+ *     C function: int sqlc_session_enable(sqlc_handle_t session, int enable);
  */
-JNIEXPORT jstring JNICALL 
-Java_io_liteglue_SQLiteNative_sqlc_1errstr_1native__I(JNIEnv *env, jclass _unused, jint errcode) {
-  const char *  _res;
-  _res = sqlc_errstr_native((int) errcode);
-  if (NULL == _res) return NULL;
-  return (*env)->NewStringUTF(env, _res);
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1session_1enable__JI(JNIEnv *env, jclass _unused, jlong session, jint enable) {
+  int _res;
+  _res = sqlc_session_enable((sqlc_handle_t) session, (int) enable);
+  return _res;
 }
 
 
 /*   Java->C glue code:
  *   Java package: io.liteglue.SQLiteNative
- *    Java method: void sqlc_fj_dispose(long fj)
- *     C function: void sqlc_fj_dispose(sqlc_handle_t fj);
+ *    Java method: long sqlc_soft_heap_limit(long n)
+ *     C function: sqlc_long_t sqlc_soft_heap_limit(sqlc_long_t n);
  */
-JNIEXPORT void JNICALL 
-Java_io_liteglue_SQLiteNative_sqlc_1fj_1dispose__J(JNIEnv *env, jclass _unused, jlong fj) {
-  sqlc_fj_dispose((sqlc_handle_t) fj);
+JNIEXPORT jlong JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1soft_1heap_1limit__J(JNIEnv *env, jclass _unused, jlong n) {
+  sqlc_long_t _res;
+  _res = sqlc_soft_heap_limit((sqlc_long_t) n);
+  return _res;
 }
 
 
 /*   Java->C glue code:
  *   Java package: io.liteglue.SQLiteNative
- *    Java method: java.lang.String sqlc_fj_run(long fj, java.lang.String batch_json, int ll)
- *     C function: const char *  sqlc_fj_run(sqlc_handle_t fj, const char *  batch_json, int ll);
+ *    Java method: int sqlc_st_bind_all0(long st, java.lang.Object buf, int buf_byte_offset, int len)
+ *     C function: int sqlc_st_bind_all(sqlc_handle_t st, const void *  buf, int len);
  */
-JNIEXPORT jstring JNICALL 
-Java_io_liteglue_SQLiteNative_sqlc_1fj_1run__JLjava_lang_String_2I(JNIEnv *env, jclass _unused, jlong fj, jstring batch_json, jint ll) {
-  const char* _strchars_batch_json = NULL;
-  const char *  _res;
-  if ( NULL != batch_json ) {
-    _strchars_batch_json = (*env)->GetStringUTFChars(env, batch_json, (jboolean*)NULL);
-  if ( NULL == _strchars_batch_json ) {
-      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
-                       "Failed to get UTF-8 chars for argument \"batch_json\" in native dispatcher for \"sqlc_fj_run\"");
-      return 0;
-    }
-  }
-  _res = sqlc_fj_run((sqlc_handle_t) fj, (char *) _strchars_batch_json, (int) ll);
-  if ( NULL != batch_json ) {
-    (*env)->ReleaseStringUTFChars(env, batch_json, _strchars_batch_json);
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1st_1bind_1all0__JLjava_lang_Object_2II(JNIEnv *env, jclass _unused, jlong st, jobject buf, jint buf_byte_offset, jint len) {
+  void * _buf_ptr = NULL;
+  int _res;
+  if ( NULL != buf ) {
+    _buf_ptr = (void *) (((char*) (*env)->GetDirectBufferAddress(env, buf)) + buf_byte_offset);
   }
-  if (NULL == _res) return NULL;
-  return (*env)->NewStringUTF(env, _res);
+  _res = sqlc_st_bind_all((sqlc_handle_t) st, (void *) _buf_ptr, (int) len);
+  return _res;
 }
 
 
@@ -326,6 +1357,19 @@ Java_io_liteglue_SQLiteNative_sqlc_1st_1bind_1text_1native__JILjava_lang_String_
 }
 
 
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_st_clear_bindings(long st)
+ *     C function: int sqlc_st_clear_bindings(sqlc_handle_t st);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1st_1clear_1bindings__J(JNIEnv *env, jclass _unused, jlong st) {
+  int _res;
+  _res = sqlc_st_clear_bindings((sqlc_handle_t) st);
+  return _res;
+}
+
+
 /*   Java->C glue code:
  *   Java package: io.liteglue.SQLiteNative
  *    Java method: int sqlc_st_column_count(long st)
@@ -432,6 +1476,19 @@ Java_io_liteglue_SQLiteNative_sqlc_1st_1finish__J(JNIEnv *env, jclass _unused, j
 }
 
 
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_st_reset(long st)
+ *     C function: int sqlc_st_reset(sqlc_handle_t st);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1st_1reset__J(JNIEnv *env, jclass _unused, jlong st) {
+  int _res;
+  _res = sqlc_st_reset((sqlc_handle_t) st);
+  return _res;
+}
+
+
 /*   Java->C glue code:
  *   Java package: io.liteglue.SQLiteNative
  *    Java method: int sqlc_st_step(long st)
@@ -445,3 +1502,71 @@ Java_io_liteglue_SQLiteNative_sqlc_1st_1step__J(JNIEnv *env, jclass _unused, jlo
 }
 
 
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_temp_directory(java.lang.String dir)
+ *     C function: int sqlc_temp_directory(const char *  dir);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1temp_1directory__Ljava_lang_String_2(JNIEnv *env, jclass _unused, jstring dir) {
+  const char* _strchars_dir = NULL;
+  int _res;
+  if ( NULL != dir ) {
+    _strchars_dir = (*env)->GetStringUTFChars(env, dir, (jboolean*)NULL);
+  if ( NULL == _strchars_dir ) {
+      (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/OutOfMemoryError"),
+                       "Failed to get UTF-8 chars for argument \"dir\" in native dispatcher for \"sqlc_temp_directory\"");
+      return 0;
+    }
+  }
+  _res = sqlc_temp_directory((char *) _strchars_dir);
+  if ( NULL != dir ) {
+    (*env)->ReleaseStringUTFChars(env, dir, _strchars_dir);
+  }
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_trace_drain0(long trace, java.lang.Object buf, int buf_byte_offset, int len)
+ *     C function: int sqlc_trace_drain(sqlc_handle_t trace, void *  buf, int len);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1trace_1drain0__JLjava_lang_Object_2II(JNIEnv *env, jclass _unused, jlong trace, jobject buf, jint buf_byte_offset, jint len) {
+  void * _buf_ptr = NULL;
+  int _res;
+  if ( NULL != buf ) {
+    _buf_ptr = (void *) (((char*) (*env)->GetDirectBufferAddress(env, buf)) + buf_byte_offset);
+  }
+  _res = sqlc_trace_drain((sqlc_handle_t) trace, (void *) _buf_ptr, (int) len);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: long sqlc_trace_dropped(long trace)
+ *     C function: sqlc_long_t sqlc_trace_dropped(sqlc_handle_t trace);
+ */
+JNIEXPORT jlong JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1trace_1dropped__J(JNIEnv *env, jclass _unused, jlong trace) {
+  sqlc_long_t _res;
+  _res = sqlc_trace_dropped((sqlc_handle_t) trace);
+  return _res;
+}
+
+
+/*   Java->C glue code:
+ *   Java package: io.liteglue.SQLiteNative
+ *    Java method: int sqlc_trace_stop(long trace)
+ *     C function: int sqlc_trace_stop(sqlc_handle_t trace);
+ */
+JNIEXPORT jint JNICALL 
+Java_io_liteglue_SQLiteNative_sqlc_1trace_1stop__J(JNIEnv *env, jclass _unused, jlong trace) {
+  int _res;
+  _res = sqlc_trace_stop((sqlc_handle_t) trace);
+  return _res;
+}
+
+
@@ -2,7 +2,9 @@
 
 #include <stddef.h> /* for NULL */
 
+#ifdef SQLC_KEEP_ANDROID_LOG
 #include <android/log.h>
+#endif
 
 #include "sqlite3.h"
 
@@ -10,6 +12,24 @@
 
 #include <stdbool.h>
 
+#include <limits.h> /* for INT_MAX */
+
+#include <time.h> /* for clock_gettime() */
+
+#include <pthread.h>
+
+#include <malloc.h> /* for malloc_usable_size() */
+
+#include <fcntl.h> /* for open() */
+#include <unistd.h> /* for write(), close() */
+#include <errno.h>
+
+#include <sys/mman.h> /* for mmap() */
+#include <sys/stat.h> /* for fstat() */
+
+#include <math.h> /* for haversine() */
+#include <regex.h> /* for REGEXP */
+
 #define BASE_HANDLE_OFFSET 0x100000000LL
 
 #ifdef SQLC_KEEP_ANDROID_LOG
@@ -48,6 +68,22 @@ sqlc_handle_t sqlc_db_open(const char *filename, int flags)
   return (r1 == 0) ? HANDLE_FROM_VP(d1) : -r1;
 }
 
+sqlc_handle_t sqlc_db_open_vfs(const char *filename, int flags, const char *vfs)
+{
+  sqlite3 *d1;
+  int r1;
+
+  MYLOG("db_open_vfs %s %d %s", filename, flags, vfs);
+
+  r1 = sqlite3_open_v2(filename, &d1, flags, vfs);
+
+  MYLOG("db_open_vfs %s result %d ptr %p", filename, r1, d1);
+
+  if (r1 != 0) sqlite3_close(d1);
+
+  return (r1 == 0) ? HANDLE_FROM_VP(d1) : -r1;
+}
+
 sqlc_handle_t sqlc_db_prepare_st(sqlc_handle_t db, const char *sql)
 {
   sqlite3 *mydb = HANDLE_TO_VP(db);
@@ -105,6 +141,13 @@ int sqlc_db_total_changes(sqlc_handle_t db)
   return sqlite3_total_changes(mydb);
 }
 
+sqlc_long_t sqlc_db_total_changes64(sqlc_handle_t db)
+{
+  sqlite3 *mydb = HANDLE_TO_VP(db);
+
+  return sqlite3_total_changes64(mydb);
+}
+
 int sqlc_db_errcode(sqlc_handle_t db)
 {
   sqlite3 *mydb = HANDLE_TO_VP(db);
@@ -166,6 +209,73 @@ int sqlc_st_bind_text_native(sqlc_handle_t st, int col, const char *val)
   return sqlite3_bind_text(myst, col, val, -1, SQLITE_TRANSIENT);
 }
 
+int sqlc_st_bind_all(sqlc_handle_t st, const void *buf, int len)
+{
+  sqlite3_stmt *myst = HANDLE_TO_VP(st);
+  const char * p = buf;
+  const char * end = p + len;
+  int pos = 0;
+
+  MYLOG("%s %p %d", __func__, myst, len);
+
+  if (buf == NULL || len < 0) return SQLITE_MISUSE;
+
+  while (p < end) {
+    int type, n;
+    int rv;
+
+    if (end - p < 4) return SQLITE_MISUSE;
+    memcpy(&type, p, 4);
+    p += 4;
+    ++pos;
+
+    switch (type) {
+    case SQLC_INTEGER:
+      {
+        sqlite3_int64 v;
+        if (end - p < 8) return SQLITE_MISUSE;
+        memcpy(&v, p, 8);
+        p += 8;
+        rv = sqlite3_bind_int64(myst, pos, v);
+      }
+      break;
+
+    case SQLC_FLOAT:
+      {
+        double v;
+        if (end - p < 8) return SQLITE_MISUSE;
+        memcpy(&v, p, 8);
+        p += 8;
+        rv = sqlite3_bind_double(myst, pos, v);
+      }
+      break;
+
+    case SQLC_TEXT:
+    case SQLC_BLOB:
+      if (end - p < 4) return SQLITE_MISUSE;
+      memcpy(&n, p, 4);
+      p += 4;
+      if (n < 0 || end - p < n) return SQLITE_MISUSE;
+      rv = (type == SQLC_TEXT) ?
+        sqlite3_bind_text(myst, pos, p, n, SQLITE_TRANSIENT) :
+        sqlite3_bind_blob(myst, pos, p, n, SQLITE_TRANSIENT);
+      p += n;
+      break;
+
+    case SQLC_NULL:
+      rv = sqlite3_bind_null(myst, pos);
+      break;
+
+    default:
+      return SQLITE_MISUSE;
+    }
+
+    if (rv != SQLITE_OK) return rv;
+  }
+
+  return SQLITE_OK;
+}
+
 int sqlc_st_step(sqlc_handle_t stmt)
 {
   sqlite3_stmt *mystmt = HANDLE_TO_VP(stmt);
@@ -224,556 +334,3774 @@ int sqlc_st_column_type(sqlc_handle_t st, int col)
   return sqlite3_column_type(myst, col);
 }
 
-int sqlc_st_finish(sqlc_handle_t st)
+int sqlc_st_reset(sqlc_handle_t st)
 {
   sqlite3_stmt *myst = HANDLE_TO_VP(st);
 
   MYLOG("%s %p", __func__, myst);
 
-  return sqlite3_finalize(myst);
+  return sqlite3_reset(myst);
 }
 
-int sqlc_db_close(sqlc_handle_t db)
+int sqlc_st_clear_bindings(sqlc_handle_t st)
 {
-  sqlite3 *mydb = HANDLE_TO_VP(db);
+  sqlite3_stmt *myst = HANDLE_TO_VP(st);
 
-  MYLOG("%s %p", __func__, mydb);
+  MYLOG("%s %p", __func__, myst);
 
-// XXX TBD consider sqlite3_close() vs sqlite3_close_v2() ??:
-  return sqlite3_close(mydb);
+  return sqlite3_clear_bindings(myst);
 }
 
-struct fj_s {
-  sqlite3 * mydb;
-  void * cleanup1;
-  void * cleanup2;
-};
+int sqlc_st_finish(sqlc_handle_t st)
+{
+  sqlite3_stmt *myst = HANDLE_TO_VP(st);
 
-sqlc_handle_t sqlc_db_new_fj(sqlc_handle_t db)
+  MYLOG("%s %p", __func__, myst);
+
+  return sqlite3_finalize(myst);
+}
+
+sqlc_handle_t sqlc_blob_open(sqlc_handle_t db, const char *db_name, const char *table, const char *column, sqlc_long_t row, int flags)
 {
   sqlite3 *mydb = HANDLE_TO_VP(db);
+  sqlite3_blob *b = NULL;
+  int rv;
 
-  struct fj_s * myfj = malloc(sizeof(struct fj_s));
-  myfj->mydb = mydb;
-  myfj->cleanup1 = NULL;
-  myfj->cleanup2 = NULL;
+  MYLOG("%s %p %s %s %s %lld %d", __func__, mydb, db_name, table, column, row, flags);
 
-  return HANDLE_FROM_VP(myfj);
+  rv = sqlite3_blob_open(mydb, (db_name == NULL) ? "main" : db_name, table, column, row, flags, &b);
+
+  return (rv == 0) ? HANDLE_FROM_VP(b) : -rv;
 }
 
-void sqlc_fj_dispose(sqlc_handle_t fj)
+int sqlc_blob_bytes(sqlc_handle_t blob)
 {
-  struct fj_s * myfj = HANDLE_TO_VP(fj);
-  free(myfj->cleanup1);
-  free(myfj->cleanup2);
-  free(myfj);
+  return sqlite3_blob_bytes(HANDLE_TO_VP(blob));
 }
 
-int sj(const char * j, int tl, char * a)
+int sqlc_blob_read(sqlc_handle_t blob, void *buf, int n, int offset)
 {
-  int ti=0;
-  int ai=0;
-  while (ti<tl) {
-    char c = j[ti];
-    if (c == '\\') {
-      // XXX TODO TODO TODO TODO TODO
-      switch(j[ti+1]) {
-      case '\"':
-        a[ai++] = '\"';
-        ti += 2;
-        break;
+  sqlite3_blob *myblob = HANDLE_TO_VP(blob);
 
-      case '\\':
-        a[ai++] = '\\';
-        ti += 2;
-        break;
+  MYLOG("%s %p %p %d %d", __func__, myblob, buf, n, offset);
 
-      case 'r':
-        a[ai++] = '\r';
-        ti += 2;
-        break;
+  if (buf == NULL) return SQLITE_MISUSE;
 
-      case 'n':
-        a[ai++] = '\n';
-        ti += 2;
-        break;
+  return sqlite3_blob_read(myblob, buf, n, offset);
+}
 
-      case 't':
-        //a[ai++] = '\t';
-        //sprintf(a+ai, ".tab.");
-        //ai += strlen(a+ai);
-        a[ai++] = '\t';
-        ti += 2;
-        break;
+int sqlc_blob_write(sqlc_handle_t blob, const void *buf, int n, int offset)
+{
+  sqlite3_blob *myblob = HANDLE_TO_VP(blob);
 
-      default:
-        // XXX TODO what to do??
-        ti += 2;
-        break;
-      }
-    } else if (c >= 0xe0) {
-      //sprintf(a+ai, ".%02x.%02x.%02x.", c, j[ti+1], j[ti+2]);
-      //ai += strlen(a+ai);
-      //ti += 3;
-      a[ai++]=j[ti++];
-      a[ai++]=j[ti++];
-      a[ai++]=j[ti++];
-    } else if (c >= 0xc0) {
-      //sprintf(a+ai, ".%02x.%02x.", c, j[ti+1]);
-      //ai += strlen(a+ai);
-      //ti += 2;
-      a[ai++]=j[ti++];
-      a[ai++]=j[ti++];
-    } else if (c >= 128) {
-      sprintf(a+ai, "-%02x-", c);
-      ai += strlen(a+ai);
-      ti += 1;
-    } else {
-      a[ai++]=j[ti++];
-    }
-  }
+  MYLOG("%s %p %p %d %d", __func__, myblob, buf, n, offset);
 
-  return ai;
+  if (buf == NULL) return SQLITE_MISUSE;
+
+  return sqlite3_blob_write(myblob, buf, n, offset);
 }
 
-const char *sqlc_fj_run(sqlc_handle_t fj, const char *batch_json, int ll)
+int sqlc_blob_reopen(sqlc_handle_t blob, sqlc_long_t row)
 {
-// XXX MAJOR TODO(s)
-// handle constraint violation
-// extra json char issue(s)
-// basic optimization(s)
-//
-// DOUBLE-CHECK:
-// deal with json char issues
-// check return values
-// error handling
-// bind args
-// deal with numbers, true/false, null, etc. etc. etc.
-// rowsAffected/insertId
-// opt keep track of result json position
-// double-check for possible memory overflows
+  sqlite3_blob *myblob = HANDLE_TO_VP(blob);
 
-  struct fj_s * myfj = HANDLE_TO_VP(fj);
-  sqlite3 *mydb = myfj->mydb;
+  MYLOG("%s %p %lld", __func__, myblob, row);
 
-  jsmn_parser myparser;
-  jsmntok_t *tokn = NULL;
-  int r = -1;
+  return sqlite3_blob_reopen(myblob, row);
+}
 
-  int as = 0;
-  int flen = 0;
-  char nf[22];
-  int nflen = 0;
+int sqlc_blob_close(sqlc_handle_t blob)
+{
+  sqlite3_blob *myblob = HANDLE_TO_VP(blob);
 
-  int fi = 0;
-  sqlite3_stmt *s = NULL;
-  int rv = -1;
-  int jj, cc;
-  int param_count = 0;
-  int bi = 0;
+  MYLOG("%s %p", __func__, myblob);
 
-  // FUTURE TBD optimize?
-  // For alloc memory test:
-  //const FIRST_ALLOC = 40;
-  // Desired for normal situations:
-  //const FIRST_ALLOC = 1000;
-  // XXX TBD NEEDED to pass big memory test:
-  const FIRST_ALLOC = 10000;
-  const NEXT_ALLOC = 80; // extra extra padding extra extra padding
+  return sqlite3_blob_close(myblob);
+}
 
-  char * rr;
-  int rrlen = 0;
-  int arlen = 0;
-  const char * pptext = 0;
-  int pplen = 0;
+sqlc_handle_t sqlc_backup_init(sqlc_handle_t dest_db, const char *dest_name, sqlc_handle_t src_db, const char *src_name)
+{
+  sqlite3 *mydest = HANDLE_TO_VP(dest_db);
+  sqlite3 *mysrc = HANDLE_TO_VP(src_db);
+  sqlite3_backup *b;
 
-// Double alloc every time:
-//#define EXTRA_ALLOC rrlen
-// Extra half alloc every time:
-//#define EXTRA_ALLOC (rrlen >> 1)
-// Hybrid double/extra half alloc every time (seems best for bulk scenarios):
-#define EXTRA_ALLOC ((rrlen < 1000000) ? rrlen : (rrlen >> 1))
-//#define EXTRA_ALLOC ((rrlen < 1000000) ? 1000000 : (rrlen >> 1))
-// Don't double or extra half alloc every time (for extra alloc memory test):
-//#define EXTRA_ALLOC 11
+  MYLOG("%s %p %s %p %s", __func__, mydest, dest_name, mysrc, src_name);
 
-// EXTRA NOTE: Use of realloc seems to break under some bulk scenarios.
-// WORKAROUND is to do malloc/memcpy/free instead.
-// TBD VERY strange!
+  b = sqlite3_backup_init(mydest, (dest_name == NULL) ? "main" : dest_name,
+    mysrc, (src_name == NULL) ? "main" : src_name);
 
-  free(myfj->cleanup1);
-  myfj->cleanup1 = NULL;
-  free(myfj->cleanup2);
-  myfj->cleanup2 = NULL;
+  // NOTE: error code is stored in the destination db handle:
+  return (b != NULL) ? HANDLE_FROM_VP(b) : -sqlite3_errcode(mydest);
+}
 
-  //tokn = tokns;
-  myfj->cleanup1 = tokn = malloc(ll*sizeof(jsmntok_t));
+int sqlc_backup_step(sqlc_handle_t backup, int pages)
+{
+  sqlite3_backup *mybackup = HANDLE_TO_VP(backup);
 
-  if (tokn == NULL) goto batchmemoryerror;
+  MYLOG("%s %p %d", __func__, mybackup, pages);
 
-  jsmn_init(&myparser);
-  r = jsmn_parse(&myparser, batch_json, strlen(batch_json), tokn, ll);
-  if (r < 0) return "{\"message\": \"jsmn_parse error 1\"}";
+  return sqlite3_backup_step(mybackup, pages);
+}
 
-  // FUTURE TBD check for tok overflow?
-  //if (i >= r) return "{\"message\": \"memory error 1\"}";
+int sqlc_backup_remaining(sqlc_handle_t backup)
+{
+  return sqlite3_backup_remaining(HANDLE_TO_VP(backup));
+}
 
-  if (tokn->type != JSMN_ARRAY) return "{\"message\": \"missing array 1\"}";
-  as = tokn->size;
-  ++tokn;
+int sqlc_backup_pagecount(sqlc_handle_t backup)
+{
+  return sqlite3_backup_pagecount(HANDLE_TO_VP(backup));
+}
 
-#if 0
-  if (tokn->type != JSMN_OBJECT) return "{\"message\": \"missing object 1\"}";
-  ++tokn;
+int sqlc_backup_finish(sqlc_handle_t backup)
+{
+  sqlite3_backup *mybackup = HANDLE_TO_VP(backup);
 
-  // dbargs (ignored)
-  if (tokn->type != JSMN_STRING) return "{\"message\": \"type error 1\"}";
-  if (strncmp(batch_json+tokn->start, "dbargs", 6) != 0)
-    return "{\"message\": \"arg error 1\"}";
-  ++tokn;
+  MYLOG("%s %p", __func__, mybackup);
 
-  if (tokn->type != JSMN_OBJECT) return "{\"message\": \"type error 2\"}";
-  tokn = tokn + (tokn->size << 1);
-  ++tokn;
+  return sqlite3_backup_finish(mybackup);
+}
 
-  // flen
-  if (tokn->type != JSMN_STRING) return "{\"message\": \"type error 3\"}";
-  if (strncmp(batch_json+tokn->start, "flen", 4) != 0)
-    return "{\"message\": \"arg error 2\"}";
-  ++tokn;
-  if (tokn->type != JSMN_PRIMITIVE) return "{\"message\": \"type error 4\"}";
-  nflen = tokn->end-tokn->start;
-  strncpy(nf, batch_json+tokn->start, nflen);
-  nf[nflen] = '\0';
-  flen = atoi(nf);
-  ++tokn;
+struct sqlc_trace_event {
+  sqlc_long_t time_ns;
+  sqlc_long_t handle;
+  sqlc_long_t value;
+  int type;
+  int reserved;
+};
 
-  // flatlist
-  if (tokn->type != JSMN_STRING) return "{\"message\": \"type error 5\"}";
-  if (strncmp(batch_json+tokn->start, "flatlist", 8) != 0)
-    return "{\"message\": \"arg error 3\"}";
-  ++tokn;
-  if (tokn->type != JSMN_ARRAY) return "{\"message\": \"type error 6\"}";
-  // TODO get flatlist length
-  ++tokn;
-#endif
+// Single producer (the db thread), single consumer (drain) ring, lock-free:
+struct sqlc_trace {
+  sqlite3 * mydb;
+  unsigned int mask; // capacity - 1
+  sqlc_long_t head; // next event to write
+  sqlc_long_t tail; // next event to drain
+  sqlc_long_t dropped;
+  struct sqlc_trace_event ev[1];
+};
 
-#if 1
-  // dbid
-  if (tokn->type != JSMN_PRIMITIVE) return "{\"message\": \"type error 4\"}";
-  ++tokn;
+static int sqlc_trace_cb(unsigned int t, void * c, void * p, void * x)
+{
+  struct sqlc_trace * tr = c;
+  sqlc_long_t head = __atomic_load_n(&tr->head, __ATOMIC_RELAXED);
+  struct sqlc_trace_event * e;
+  struct timespec ts;
+
+  if (head - __atomic_load_n(&tr->tail, __ATOMIC_ACQUIRE) > tr->mask) {
+    __atomic_fetch_add(&tr->dropped, 1, __ATOMIC_RELAXED);
+    return 0;
+  }
 
-  // flen (batch length)
-  if (tokn->type != JSMN_PRIMITIVE) return "{\"message\": \"type error 4a\"}";
-  nflen = tokn->end-tokn->start;
-  strncpy(nf, batch_json+tokn->start, nflen);
-  nf[nflen] = '\0';
-  flen = atoi(nf);
-  ++tokn;
-#endif
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  e = &tr->ev[head & tr->mask];
+  e->time_ns = (sqlc_long_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+  e->handle = HANDLE_FROM_VP(p);
+  e->value = 0;
+  e->type = t;
+  e->reserved = 0;
+
+  if (t == SQLITE_TRACE_PROFILE) {
+    e->value = *(sqlite3_int64 *)x;
+  } else if (t == SQLITE_TRACE_STMT) {
+    // FNV-1a hash of the (unexpanded) SQL text:
+    const unsigned char * sql = x;
+    unsigned int h = 2166136261U;
+    while (*sql) {
+      h ^= *sql++;
+      h *= 16777619U;
+    }
+    e->value = h;
+  }
+
+  __atomic_store_n(&tr->head, head + 1, __ATOMIC_RELEASE);
+  return 0;
+}
+
+sqlc_handle_t sqlc_db_trace_start(sqlc_handle_t db, int mask, int capacity)
+{
+  sqlite3 *mydb = HANDLE_TO_VP(db);
+  struct sqlc_trace * tr;
+  int n = 1;
+  int rv;
+
+  MYLOG("%s %p %d %d", __func__, mydb, mask, capacity);
+
+  if (capacity < 1 || capacity > (1 << 24)) return -SQLITE_MISUSE;
+  while (n < capacity) n <<= 1;
+
+  tr = calloc(1, sizeof(struct sqlc_trace) + (n-1) * sizeof(struct sqlc_trace_event));
+  if (tr == NULL) return -SQLITE_NOMEM;
+  tr->mydb = mydb;
+  tr->mask = n - 1;
+
+  rv = sqlite3_trace_v2(mydb, mask, sqlc_trace_cb, tr);
+  if (rv != SQLITE_OK) {
+    free(tr);
+    return -rv;
+  }
+
+  return HANDLE_FROM_VP(tr);
+}
+
+int sqlc_trace_drain(sqlc_handle_t trace, void *buf, int len)
+{
+  struct sqlc_trace * tr = HANDLE_TO_VP(trace);
+  sqlc_long_t tail = __atomic_load_n(&tr->tail, __ATOMIC_RELAXED);
+  sqlc_long_t head = __atomic_load_n(&tr->head, __ATOMIC_ACQUIRE);
+  int n = 0;
+  int max = len / sizeof(struct sqlc_trace_event);
+
+  if (buf == NULL) return -SQLITE_MISUSE;
+
+  while (tail + n < head && n < max) {
+    memcpy((char *)buf + n * sizeof(struct sqlc_trace_event), &tr->ev[(tail + n) & tr->mask],
+      sizeof(struct sqlc_trace_event));
+    ++n;
+  }
+
+  __atomic_store_n(&tr->tail, tail + n, __ATOMIC_RELEASE);
+  return n * sizeof(struct sqlc_trace_event);
+}
+
+sqlc_long_t sqlc_trace_dropped(sqlc_handle_t trace)
+{
+  struct sqlc_trace * tr = HANDLE_TO_VP(trace);
+
+  return __atomic_load_n(&tr->dropped, __ATOMIC_RELAXED);
+}
+
+int sqlc_trace_stop(sqlc_handle_t trace)
+{
+  struct sqlc_trace * tr = HANDLE_TO_VP(trace);
+  int rv;
+
+  MYLOG("%s %p", __func__, tr);
+
+  rv = sqlite3_trace_v2(tr->mydb, 0, NULL, NULL);
+  free(tr);
+  return rv;
+}
+
+struct sqlc_change {
+  sqlc_long_t rowid;
+  int op;
+  int table;
+};
+
+// Single producer (the db thread), single consumer (drain) ring, lock-free.
+// Changes of the open transaction are written after head & published by the commit hook:
+struct sqlc_changes {
+  sqlite3 * mydb;
+  unsigned int mask; // capacity - 1
+  sqlc_long_t head; // next change to publish
+  sqlc_long_t pending; // next change to write
+  sqlc_long_t tail; // next change to drain
+  sqlc_long_t dropped;
+  sqlc_long_t pending_dropped;
+  int last_table; // cached id of the most recently changed table
+  int name_count;
+  char * names[SQLC_CHANGES_MAX_TABLES];
+  struct sqlc_change ch[1];
+};
+
+static int sqlc_changes_name_is(const char * n, int main, const char * schema, size_t sl, const char * table)
+{
+  if (main) return !strcmp(n, table);
+  return !strncmp(n, schema, sl) && n[sl] == '.' && !strcmp(n + sl + 1, table);
+}
+
+static int sqlc_changes_table(struct sqlc_changes * cs, const char * schema, const char * table)
+{
+  int main = !strcmp(schema, "main");
+  size_t sl = main ? 0 : strlen(schema);
+  size_t pl = main ? 0 : sl + 1; // "schema." prefix
+  size_t tl = strlen(table) + 1;
+  char * name;
+  int i;
+
+  // most recently changed table first:
+  if (cs->last_table >= 0 &&
+      sqlc_changes_name_is(cs->names[cs->last_table], main, schema, sl, table))
+    return cs->last_table;
+
+  for (i = 0; i < cs->name_count; ++i) {
+    if (sqlc_changes_name_is(cs->names[i], main, schema, sl, table))
+      return cs->last_table = i;
+  }
+
+  if (cs->name_count == SQLC_CHANGES_MAX_TABLES) return -1;
+
+  name = malloc(pl + tl);
+  if (name == NULL) return -1;
+  if (!main) {
+    memcpy(name, schema, sl);
+    name[sl] = '.';
+  }
+  memcpy(name + pl, table, tl);
+
+  cs->names[i] = name;
+  // publish the name before its id can be drained:
+  __atomic_store_n(&cs->name_count, i + 1, __ATOMIC_RELEASE);
+  return cs->last_table = i;
+}
+
+static void sqlc_changes_update_cb(void * c, int op, const char * schema, const char * table, sqlite3_int64 rowid)
+{
+  struct sqlc_changes * cs = c;
+  struct sqlc_change * e;
+
+  if (cs->pending - __atomic_load_n(&cs->tail, __ATOMIC_ACQUIRE) > cs->mask) {
+    ++cs->pending_dropped;
+    return;
+  }
+
+  e = &cs->ch[cs->pending & cs->mask];
+  e->rowid = rowid;
+  e->op = op;
+  e->table = sqlc_changes_table(cs, schema, table);
+  ++cs->pending;
+}
+
+static int sqlc_changes_commit_cb(void * c)
+{
+  struct sqlc_changes * cs = c;
+
+  if (cs->pending_dropped > 0) {
+    __atomic_fetch_add(&cs->dropped, cs->pending_dropped, __ATOMIC_RELAXED);
+    cs->pending_dropped = 0;
+  }
+  // NOTE: published before the commit is done (there is no hook after a successful commit),
+  // a commit that fails after this hook leaves the published changes in the ring
+  __atomic_store_n(&cs->head, cs->pending, __ATOMIC_RELEASE);
+  return 0; // let the commit go ahead
+}
+
+static void sqlc_changes_rollback_cb(void * c)
+{
+  struct sqlc_changes * cs = c;
+
+  cs->pending = cs->head;
+  cs->pending_dropped = 0;
+}
+
+sqlc_handle_t sqlc_db_changes_start(sqlc_handle_t db, int capacity)
+{
+  sqlite3 *mydb = HANDLE_TO_VP(db);
+  struct sqlc_changes * cs;
+  int n = 1;
+
+  MYLOG("%s %p %d", __func__, mydb, capacity);
+
+  if (capacity < 1 || capacity > (1 << 24)) return -SQLITE_MISUSE;
+  while (n < capacity) n <<= 1;
+
+  cs = calloc(1, sizeof(struct sqlc_changes) + (n-1) * sizeof(struct sqlc_change));
+  if (cs == NULL) return -SQLITE_NOMEM;
+  cs->mydb = mydb;
+  cs->mask = n - 1;
+  cs->last_table = -1;
+
+  sqlite3_update_hook(mydb, sqlc_changes_update_cb, cs);
+  sqlite3_commit_hook(mydb, sqlc_changes_commit_cb, cs);
+  sqlite3_rollback_hook(mydb, sqlc_changes_rollback_cb, cs);
+
+  return HANDLE_FROM_VP(cs);
+}
+
+int sqlc_changes_drain(sqlc_handle_t changes, void *buf, int len)
+{
+  struct sqlc_changes * cs = HANDLE_TO_VP(changes);
+  sqlc_long_t tail = __atomic_load_n(&cs->tail, __ATOMIC_RELAXED);
+  sqlc_long_t head = __atomic_load_n(&cs->head, __ATOMIC_ACQUIRE);
+  int n = 0;
+  int max = len / sizeof(struct sqlc_change);
+
+  if (buf == NULL) return -SQLITE_MISUSE;
+
+  while (tail + n < head && n < max) {
+    memcpy((char *)buf + n * sizeof(struct sqlc_change), &cs->ch[(tail + n) & cs->mask],
+      sizeof(struct sqlc_change));
+    ++n;
+  }
+
+  __atomic_store_n(&cs->tail, tail + n, __ATOMIC_RELEASE);
+  return n * sizeof(struct sqlc_change);
+}
+
+sqlc_long_t sqlc_changes_dropped(sqlc_handle_t changes)
+{
+  struct sqlc_changes * cs = HANDLE_TO_VP(changes);
+
+  return __atomic_load_n(&cs->dropped, __ATOMIC_RELAXED);
+}
+
+const char *sqlc_changes_table_name(sqlc_handle_t changes, int id)
+{
+  struct sqlc_changes * cs = HANDLE_TO_VP(changes);
+
+  if (id < 0 || id >= __atomic_load_n(&cs->name_count, __ATOMIC_ACQUIRE)) return NULL;
+
+  return cs->names[id];
+}
+
+int sqlc_changes_stop(sqlc_handle_t changes)
+{
+  struct sqlc_changes * cs = HANDLE_TO_VP(changes);
+  int i;
+
+  MYLOG("%s %p", __func__, cs);
+
+  sqlite3_update_hook(cs->mydb, NULL, NULL);
+  sqlite3_commit_hook(cs->mydb, NULL, NULL);
+  sqlite3_rollback_hook(cs->mydb, NULL, NULL);
+
+  for (i = 0; i < cs->name_count; ++i) free(cs->names[i]);
+  free(cs);
+  return SQLITE_OK;
+}
+
+// Busy handler that waits like sqlite3_busy_timeout() & counts the lock conflicts:
+struct sqlc_busy {
+  sqlite3 * mydb;
+  int timeout_ms;
+  sqlc_long_t t0; // start of the current lock conflict (ns)
+  sqlc_long_t stats[SQLC_BUSY_STAT_COUNT];
+};
+
+// ms to sleep before each retry (same as sqlite3_busy_timeout()):
+static const unsigned char sqlc_busy_delays[] = { 1, 2, 5, 10, 15, 20, 25, 25, 25, 50, 50, 100 };
+
+static sqlc_long_t sqlc_busy_now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (sqlc_long_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static int sqlc_busy_cb(void * p, int count)
+{
+  struct sqlc_busy * b = p;
+  int nd = sizeof(sqlc_busy_delays) / sizeof(sqlc_busy_delays[0]);
+  sqlc_long_t now = sqlc_busy_now_ns();
+  sqlc_long_t left, delay;
+  struct timespec ts;
+
+  if (count == 0) {
+    b->t0 = now;
+    __atomic_fetch_add(&b->stats[SQLC_BUSY_STAT_EVENTS], 1, __ATOMIC_RELAXED);
+  }
+
+  left = (sqlc_long_t)b->timeout_ms * 1000000 - (now - b->t0);
+  if (left <= 0) {
+    __atomic_fetch_add(&b->stats[SQLC_BUSY_STAT_TIMEOUTS], 1, __ATOMIC_RELAXED);
+    return 0; // give up with SQLITE_BUSY
+  }
+
+  delay = (sqlc_long_t)sqlc_busy_delays[(count < nd) ? count : nd - 1] * 1000000;
+  if (delay > left) delay = left;
+
+  ts.tv_sec = delay / 1000000000;
+  ts.tv_nsec = delay % 1000000000;
+  nanosleep(&ts, NULL);
+
+  __atomic_fetch_add(&b->stats[SQLC_BUSY_STAT_RETRIES], 1, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&b->stats[SQLC_BUSY_STAT_WAIT_NS], sqlc_busy_now_ns() - now, __ATOMIC_RELAXED);
+  return 1;
+}
+
+sqlc_handle_t sqlc_db_busy_profile_start(sqlc_handle_t db, int timeout_ms)
+{
+  sqlite3 *mydb = HANDLE_TO_VP(db);
+  struct sqlc_busy * b;
+  int rv;
+
+  MYLOG("%s %p %d", __func__, mydb, timeout_ms);
+
+  if (timeout_ms < 0) return -SQLITE_MISUSE;
+
+  b = calloc(1, sizeof(struct sqlc_busy));
+  if (b == NULL) return -SQLITE_NOMEM;
+  b->mydb = mydb;
+  b->timeout_ms = timeout_ms;
+
+  rv = sqlite3_busy_handler(mydb, sqlc_busy_cb, b);
+  if (rv != SQLITE_OK) {
+    free(b);
+    return -rv;
+  }
+
+  return HANDLE_FROM_VP(b);
+}
+
+int sqlc_busy_profile_stats(sqlc_handle_t busy, void *buf, int len, int reset)
+{
+  struct sqlc_busy * b = HANDLE_TO_VP(busy);
+  sqlc_long_t * v = buf;
+  int n = len / sizeof(sqlc_long_t);
+  int i;
+
+  if (buf == NULL) return -SQLITE_MISUSE;
+  if (n > SQLC_BUSY_STAT_COUNT) n = SQLC_BUSY_STAT_COUNT;
+
+  for (i = 0; i < SQLC_BUSY_STAT_COUNT; ++i) {
+    sqlc_long_t x = reset ? __atomic_exchange_n(&b->stats[i], 0, __ATOMIC_RELAXED) :
+      __atomic_load_n(&b->stats[i], __ATOMIC_RELAXED);
+    if (i < n) v[i] = x;
+  }
+
+  return n;
+}
+
+int sqlc_busy_profile_stop(sqlc_handle_t busy)
+{
+  struct sqlc_busy * b = HANDLE_TO_VP(busy);
+  int rv;
+
+  MYLOG("%s %p", __func__, b);
+
+  rv = sqlite3_busy_handler(b->mydb, NULL, NULL);
+  free(b);
+  return rv;
+}
+
+// { op, index of current value, index of high-water value } (-1 if not used)
+static const int sqlc_db_stat_ops[][3] = {
+  { SQLITE_DBSTATUS_CACHE_USED, SQLC_STAT_CACHE_USED, -1 },
+  { SQLITE_DBSTATUS_CACHE_USED_SHARED, SQLC_STAT_CACHE_USED_SHARED, -1 },
+  { SQLITE_DBSTATUS_CACHE_HIT, SQLC_STAT_CACHE_HIT, -1 },
+  { SQLITE_DBSTATUS_CACHE_MISS, SQLC_STAT_CACHE_MISS, -1 },
+  { SQLITE_DBSTATUS_CACHE_WRITE, SQLC_STAT_CACHE_WRITE, -1 },
+  { SQLITE_DBSTATUS_CACHE_SPILL, SQLC_STAT_CACHE_SPILL, -1 },
+  { SQLITE_DBSTATUS_LOOKASIDE_USED, SQLC_STAT_LOOKASIDE_USED, SQLC_STAT_LOOKASIDE_USED_HIGHWATER },
+  { SQLITE_DBSTATUS_LOOKASIDE_HIT, -1, SQLC_STAT_LOOKASIDE_HIT },
+  { SQLITE_DBSTATUS_LOOKASIDE_MISS_SIZE, -1, SQLC_STAT_LOOKASIDE_MISS_SIZE },
+  { SQLITE_DBSTATUS_LOOKASIDE_MISS_FULL, -1, SQLC_STAT_LOOKASIDE_MISS_FULL },
+  { SQLITE_DBSTATUS_SCHEMA_USED, SQLC_STAT_SCHEMA_USED, -1 },
+  { SQLITE_DBSTATUS_STMT_USED, SQLC_STAT_STMT_USED, -1 },
+};
+
+static const int sqlc_status_ops[][3] = {
+  { SQLITE_STATUS_MEMORY_USED, SQLC_STAT_MEMORY_USED, SQLC_STAT_MEMORY_USED_HIGHWATER },
+  { SQLITE_STATUS_MALLOC_COUNT, SQLC_STAT_MALLOC_COUNT, SQLC_STAT_MALLOC_COUNT_HIGHWATER },
+  { SQLITE_STATUS_MALLOC_SIZE, -1, SQLC_STAT_MALLOC_SIZE_HIGHWATER },
+  { SQLITE_STATUS_PAGECACHE_USED, SQLC_STAT_PAGECACHE_USED, -1 },
+  { SQLITE_STATUS_PAGECACHE_OVERFLOW, SQLC_STAT_PAGECACHE_OVERFLOW, SQLC_STAT_PAGECACHE_OVERFLOW_HIGHWATER },
+  { SQLITE_STATUS_PAGECACHE_SIZE, -1, SQLC_STAT_PAGECACHE_SIZE_HIGHWATER },
+};
+
+int sqlc_db_stats(sqlc_handle_t db, void *buf, int len, int reset)
+{
+  sqlite3 *mydb = HANDLE_TO_VP(db);
+  sqlc_long_t v[SQLC_STAT_COUNT];
+  int n = len / sizeof(sqlc_long_t);
+  int i;
+
+  MYLOG("%s %p %d %d", __func__, mydb, len, reset);
+
+  if (buf == NULL) return -SQLITE_MISUSE;
+  if (n > SQLC_STAT_COUNT) n = SQLC_STAT_COUNT;
+
+  for (i=0; i<SQLC_STAT_COUNT; ++i) v[i] = -1;
+
+  for (i=0; i<sizeof(sqlc_db_stat_ops)/sizeof(sqlc_db_stat_ops[0]); ++i) {
+    int cur = 0, hi = 0;
+    if (sqlite3_db_status(mydb, sqlc_db_stat_ops[i][0], &cur, &hi, reset) == SQLITE_OK) {
+      if (sqlc_db_stat_ops[i][1] >= 0) v[sqlc_db_stat_ops[i][1]] = cur;
+      if (sqlc_db_stat_ops[i][2] >= 0) v[sqlc_db_stat_ops[i][2]] = hi;
+    }
+  }
+
+  for (i=0; i<sizeof(sqlc_status_ops)/sizeof(sqlc_status_ops[0]); ++i) {
+    sqlite3_int64 cur = 0, hi = 0;
+    if (sqlite3_status64(sqlc_status_ops[i][0], &cur, &hi, reset) == SQLITE_OK) {
+      if (sqlc_status_ops[i][1] >= 0) v[sqlc_status_ops[i][1]] = cur;
+      if (sqlc_status_ops[i][2] >= 0) v[sqlc_status_ops[i][2]] = hi;
+    }
+  }
+
+  memcpy(buf, v, n * sizeof(sqlc_long_t));
+  return n;
+}
+
+int sqlc_db_close(sqlc_handle_t db)
+{
+  sqlite3 *mydb = HANDLE_TO_VP(db);
+
+  MYLOG("%s %p", __func__, mydb);
+
+// XXX TBD consider sqlite3_close() vs sqlite3_close_v2() ??:
+  return sqlite3_close(mydb);
+}
+
+void sqlc_db_interrupt(sqlc_handle_t db)
+{
+  sqlite3 *mydb = HANDLE_TO_VP(db);
+
+  MYLOG("%s %p", __func__, mydb);
+
+  sqlite3_interrupt(mydb);
+}
+
+struct fj_s {
+  sqlite3 * mydb;
+  void * cleanup1;
+  void * cleanup2;
+  int budget_ms;
+  sqlc_long_t budget_steps;
+  sqlc_long_t deadline;
+  sqlc_long_t steps;
+  struct fj_cache * cache;
+  sqlite3_stmt ** reg_st; // registered statements (ID = index + 1)
+  int reg_count;
+  int reg_alloc;
+  bool pipeline;
+#ifdef SQLC_FJ_STATS
+  sqlc_long_t stats[SQLC_FJ_STAT_COUNT];
+#endif
+  bool busy; // in sqlc_fj_run()
+  struct fj_s * list_prev;
+  struct fj_s * list_next;
+};
+
+// all fj handles, to release memory (busy & list links protected by the mutex):
+static pthread_mutex_t fj_list_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct fj_s * fj_list = NULL;
+
+// Allocation accounting (compiled out unless built with -DSQLC_FJ_STATS):
+#ifdef SQLC_FJ_STATS
+// count an allocation of n bytes (isbuf: result buffer, with copied bytes from the old buffer)
+static void fj_stat_alloc(sqlc_long_t * st, sqlc_long_t n, sqlc_long_t copied, bool isbuf)
+{
+  st[SQLC_FJ_STAT_RUN_ALLOCS] += 1;
+  st[SQLC_FJ_STAT_RUN_BYTES] += n;
+  st[SQLC_FJ_STAT_RUN_COPIED] += copied;
+  if (isbuf && n > st[SQLC_FJ_STAT_RUN_PEAK]) st[SQLC_FJ_STAT_RUN_PEAK] = n;
+  st[SQLC_FJ_STAT_TOTAL_ALLOCS] += 1;
+  st[SQLC_FJ_STAT_TOTAL_BYTES] += n;
+  st[SQLC_FJ_STAT_TOTAL_COPIED] += copied;
+  if (isbuf && n > st[SQLC_FJ_STAT_TOTAL_PEAK]) st[SQLC_FJ_STAT_TOTAL_PEAK] = n;
+}
+
+static void fj_stat_merge(sqlc_long_t * st, const sqlc_long_t * src)
+{
+  int i;
+  for (i=0; i<SQLC_FJ_STAT_COUNT; ++i) {
+    if (i == SQLC_FJ_STAT_RUN_PEAK || i == SQLC_FJ_STAT_TOTAL_PEAK) {
+      if (src[i] > st[i]) st[i] = src[i];
+    } else {
+      st[i] += src[i];
+    }
+  }
+}
+
+#define FJ_STAT_ALLOC(st, n) fj_stat_alloc((st), (n), 0, false)
+#define FJ_STAT_BUF(st, n, copied) fj_stat_alloc((st), (n), (copied), true)
+#else
+#define FJ_STAT_ALLOC(st, n)
+#define FJ_STAT_BUF(st, n, copied)
+#endif
+
+// registered statements are kept for reuse:
+#define FJ_RELEASE_ST(s, reg) do { \
+  if (!(reg)) sqlite3_finalize(s); \
+  else if ((s) != NULL) { sqlite3_reset(s); sqlite3_clear_bindings(s); } \
+} while (0)
+
+// number of VM steps between budget checks:
+#define FJ_PROGRESS_OPS 1000
+
+static sqlc_long_t fj_now_ms(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (sqlc_long_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static int fj_progress(void * p)
+{
+  struct fj_s * myfj = p;
+
+  myfj->steps += FJ_PROGRESS_OPS;
+
+  // non-zero result interrupts the running statement:
+  if (myfj->budget_steps > 0 && myfj->steps >= myfj->budget_steps) return 1;
+  if (myfj->budget_ms > 0 && fj_now_ms() >= myfj->deadline) return 1;
+  return 0;
+}
+
+// Read query result cache:
+// encoded result fragments keyed by the raw JSON of the SQL & its parameters
+
+struct fj_cache_entry {
+  struct fj_cache_entry * next; // in hash bucket
+  struct fj_cache_entry * lru_prev;
+  struct fj_cache_entry * lru_next;
+  unsigned int hash;
+  int keylen;
+  int vallen;
+  char data[1]; // key followed by value
+};
+
+#define FJ_CACHE_BUCKETS 256
+
+struct fj_cache {
+  int max_bytes;
+  int used_bytes;
+  bool frozen; // no more entries for the current run (after a write)
+  sqlc_long_t version[3]; // data_version, schema_version, total_changes
+  struct fj_cache_entry * lru_first; // most recently used
+  struct fj_cache_entry * lru_last;
+  struct fj_cache_entry * buckets[FJ_CACHE_BUCKETS];
+};
+
+static unsigned int fj_cache_hash(const char * k, size_t kl)
+{
+  // FNV-1a:
+  unsigned int h = 2166136261U;
+  size_t i;
+  for (i=0; i<kl; ++i) {
+    h ^= (unsigned char)k[i];
+    h *= 16777619U;
+  }
+  return h;
+}
+
+static void fj_cache_unlink(struct fj_cache * c, struct fj_cache_entry * e)
+{
+  if (e->lru_prev != NULL) e->lru_prev->lru_next = e->lru_next;
+  else c->lru_first = e->lru_next;
+  if (e->lru_next != NULL) e->lru_next->lru_prev = e->lru_prev;
+  else c->lru_last = e->lru_prev;
+}
+
+static void fj_cache_push(struct fj_cache * c, struct fj_cache_entry * e)
+{
+  e->lru_prev = NULL;
+  e->lru_next = c->lru_first;
+  if (c->lru_first != NULL) c->lru_first->lru_prev = e;
+  else c->lru_last = e;
+  c->lru_first = e;
+}
+
+static void fj_cache_remove(struct fj_cache * c, struct fj_cache_entry * e)
+{
+  struct fj_cache_entry ** pp = &c->buckets[e->hash % FJ_CACHE_BUCKETS];
+  while (*pp != e) pp = &(*pp)->next;
+  *pp = e->next;
+  fj_cache_unlink(c, e);
+  c->used_bytes -= sizeof(struct fj_cache_entry) + e->keylen + e->vallen;
+  free(e);
+}
+
+static void fj_cache_clear(struct fj_cache * c)
+{
+  while (c->lru_last != NULL) fj_cache_remove(c, c->lru_last);
+}
+
+static struct fj_cache_entry * fj_cache_find(struct fj_cache * c, unsigned int h, const char * k, size_t kl)
+{
+  struct fj_cache_entry * e = c->buckets[h % FJ_CACHE_BUCKETS];
+  while (e != NULL) {
+    if (e->hash == h && (size_t)e->keylen == kl && memcmp(e->data, k, kl) == 0) {
+      fj_cache_unlink(c, e);
+      fj_cache_push(c, e);
+      return e;
+    }
+    e = e->next;
+  }
+  return NULL;
+}
+
+static void fj_cache_put(struct fj_cache * c, unsigned int h, const char * k, size_t kl, const char * v, size_t vl)
+{
+  size_t es = sizeof(struct fj_cache_entry) + kl + vl;
+  struct fj_cache_entry * e;
+
+  if (c->frozen || es > (size_t)c->max_bytes) return;
+
+  while (c->used_bytes + es > c->max_bytes) fj_cache_remove(c, c->lru_last);
+
+  e = malloc(es);
+  if (e == NULL) return;
+  e->hash = h;
+  e->keylen = kl;
+  e->vallen = vl;
+  memcpy(e->data, k, kl);
+  memcpy(e->data+kl, v, vl);
+  e->next = c->buckets[h % FJ_CACHE_BUCKETS];
+  c->buckets[h % FJ_CACHE_BUCKETS] = e;
+  fj_cache_push(c, e);
+  c->used_bytes += es;
+}
+
+// Drop all entries if the database may have changed since the last run:
+static void fj_cache_begin(sqlite3 * mydb, struct fj_cache * c)
+{
+  sqlite3_stmt * vs;
+  sqlc_long_t v[3] = { -1, -1, sqlite3_total_changes64(mydb) };
+
+  // data_version detects changes by other connections, schema_version detects DDL,
+  // total_changes detects DML on this connection.
+  if (sqlite3_prepare_v2(mydb, "SELECT * FROM pragma_data_version, pragma_schema_version", -1, &vs, NULL) == SQLITE_OK) {
+    if (sqlite3_step(vs) == SQLITE_ROW) {
+      v[0] = sqlite3_column_int64(vs, 0);
+      v[1] = sqlite3_column_int64(vs, 1);
+    }
+    sqlite3_finalize(vs);
+  }
+
+  // NOTE: unknown version (-1) always drops the cache
+  if (v[0] == -1 || memcmp(v, c->version, sizeof(v)) != 0) {
+    fj_cache_clear(c);
+    memcpy(c->version, v, sizeof(v));
+  }
+
+  c->frozen = false;
+}
+
+// Bytes kept by an fj handle between runs (token & result buffers, cached results)
+static sqlc_long_t fj_retained(struct fj_s * myfj)
+{
+  return malloc_usable_size(myfj->cleanup1) + malloc_usable_size(myfj->cleanup2) +
+    ((myfj->cache != NULL) ? myfj->cache->used_bytes : 0);
+}
+
+// Free the token buffer & cached results of an fj handle that is not running
+// (the last result buffer is left to the owning thread: it may still be read after sqlc_fj_run() returns,
+// it is freed by the next run or dispose)
+static sqlc_long_t fj_trim(struct fj_s * myfj)
+{
+  sqlc_long_t n = malloc_usable_size(myfj->cleanup1) +
+    ((myfj->cache != NULL) ? myfj->cache->used_bytes : 0);
+
+  free(myfj->cleanup1);
+  myfj->cleanup1 = NULL;
+  if (myfj->cache != NULL) fj_cache_clear(myfj->cache);
+
+  return n;
+}
+
+// Trim all fj handles that are not running (on mydb or all if NULL), returns the number of bytes freed
+static sqlc_long_t fj_trim_all(sqlite3 * mydb)
+{
+  struct fj_s * myfj;
+  sqlc_long_t n = 0;
+
+  pthread_mutex_lock(&fj_list_mutex);
+  for (myfj = fj_list; myfj != NULL; myfj = myfj->list_next)
+    if (!myfj->busy && (mydb == NULL || myfj->mydb == mydb)) n += fj_trim(myfj);
+  pthread_mutex_unlock(&fj_list_mutex);
+
+  return n;
+}
+
+sqlc_handle_t sqlc_db_new_fj(sqlc_handle_t db)
+{
+  sqlite3 *mydb = HANDLE_TO_VP(db);
+
+  struct fj_s * myfj = malloc(sizeof(struct fj_s));
+  myfj->mydb = mydb;
+  myfj->cleanup1 = NULL;
+  myfj->cleanup2 = NULL;
+  myfj->budget_ms = 0;
+  myfj->budget_steps = 0;
+  myfj->cache = NULL;
+  myfj->reg_st = NULL;
+  myfj->reg_count = 0;
+  myfj->reg_alloc = 0;
+  myfj->pipeline = false;
+#ifdef SQLC_FJ_STATS
+  memset(myfj->stats, 0, sizeof(myfj->stats));
+#endif
+  myfj->busy = false;
+
+  pthread_mutex_lock(&fj_list_mutex);
+  myfj->list_prev = NULL;
+  myfj->list_next = fj_list;
+  if (fj_list != NULL) fj_list->list_prev = myfj;
+  fj_list = myfj;
+  pthread_mutex_unlock(&fj_list_mutex);
+
+  return HANDLE_FROM_VP(myfj);
+}
+
+int sqlc_fj_alloc_stats(sqlc_handle_t fj, void *buf, int len)
+{
+#ifdef SQLC_FJ_STATS
+  struct fj_s * myfj = HANDLE_TO_VP(fj);
+  int n = len / sizeof(sqlc_long_t);
+
+  if (buf == NULL) return -SQLITE_MISUSE;
+  if (n > SQLC_FJ_STAT_COUNT) n = SQLC_FJ_STAT_COUNT;
+
+  memcpy(buf, myfj->stats, n * sizeof(sqlc_long_t));
+  return n;
+#else
+  return 0;
+#endif
+}
+
+void sqlc_fj_set_pipeline(sqlc_handle_t fj, int enable)
+{
+  struct fj_s * myfj = HANDLE_TO_VP(fj);
+
+  MYLOG("%s %p %d", __func__, myfj, enable);
+
+  myfj->pipeline = (enable != 0);
+}
+
+int sqlc_fj_register_sql(sqlc_handle_t fj, const char *sql)
+{
+  struct fj_s * myfj = HANDLE_TO_VP(fj);
+  sqlite3_stmt *s = NULL;
+  int rv;
+
+  MYLOG("%s %p %s", __func__, myfj, sql);
+
+  if (myfj->reg_count == myfj->reg_alloc) {
+    int n = (myfj->reg_alloc == 0) ? 16 : myfj->reg_alloc * 2;
+    sqlite3_stmt ** a = realloc(myfj->reg_st, n * sizeof(sqlite3_stmt *));
+    if (a == NULL) return -SQLITE_NOMEM;
+    myfj->reg_st = a;
+    myfj->reg_alloc = n;
+  }
+
+  rv = sqlite3_prepare_v3(myfj->mydb, sql, -1, SQLITE_PREPARE_PERSISTENT, &s, NULL);
+  if (rv != SQLITE_OK) return -rv;
+  // empty SQL:
+  if (s == NULL) return -SQLITE_MISUSE;
+
+  myfj->reg_st[myfj->reg_count++] = s;
+  return myfj->reg_count;
+}
+
+int sqlc_fj_set_cache(sqlc_handle_t fj, int max_bytes)
+{
+  struct fj_s * myfj = HANDLE_TO_VP(fj);
+
+  MYLOG("%s %p %d", __func__, myfj, max_bytes);
+
+  if (max_bytes < 0) return SQLITE_MISUSE;
+
+  if (max_bytes == 0) {
+    if (myfj->cache != NULL) fj_cache_clear(myfj->cache);
+    free(myfj->cache);
+    myfj->cache = NULL;
+    return SQLITE_OK;
+  }
+
+  if (myfj->cache == NULL) {
+    myfj->cache = calloc(1, sizeof(struct fj_cache));
+    if (myfj->cache == NULL) return SQLITE_NOMEM;
+  }
+
+  myfj->cache->max_bytes = max_bytes;
+  while (myfj->cache->used_bytes > max_bytes)
+    fj_cache_remove(myfj->cache, myfj->cache->lru_last);
+
+  return SQLITE_OK;
+}
+
+int sqlc_fj_set_budget(sqlc_handle_t fj, int ms, sqlc_long_t vm_steps)
+{
+  struct fj_s * myfj = HANDLE_TO_VP(fj);
+
+  MYLOG("%s %p %d %lld", __func__, myfj, ms, vm_steps);
+
+  if (ms < 0 || vm_steps < 0) return SQLITE_MISUSE;
+
+  myfj->budget_ms = ms;
+  myfj->budget_steps = vm_steps;
+  return SQLITE_OK;
+}
+
+void sqlc_fj_dispose(sqlc_handle_t fj)
+{
+  struct fj_s * myfj = HANDLE_TO_VP(fj);
+
+  pthread_mutex_lock(&fj_list_mutex);
+  if (myfj->list_prev != NULL) myfj->list_prev->list_next = myfj->list_next;
+  else fj_list = myfj->list_next;
+  if (myfj->list_next != NULL) myfj->list_next->list_prev = myfj->list_prev;
+  pthread_mutex_unlock(&fj_list_mutex);
+
+  if (myfj->cache != NULL) fj_cache_clear(myfj->cache);
+  free(myfj->cache);
+  while (myfj->reg_count > 0) sqlite3_finalize(myfj->reg_st[--myfj->reg_count]);
+  free(myfj->reg_st);
+  free(myfj->cleanup1);
+  free(myfj->cleanup2);
+  free(myfj);
+}
+
+size_t sj(const char * j, size_t tl, char * a)
+{
+  size_t ti=0;
+  size_t ai=0;
+  while (ti<tl) {
+    char c = j[ti];
+    if (c == '\\') {
+      // XXX TODO TODO TODO TODO TODO
+      switch(j[ti+1]) {
+      case '\"':
+        a[ai++] = '\"';
+        ti += 2;
+        break;
+
+      case '\\':
+        a[ai++] = '\\';
+        ti += 2;
+        break;
+
+      case 'r':
+        a[ai++] = '\r';
+        ti += 2;
+        break;
+
+      case 'n':
+        a[ai++] = '\n';
+        ti += 2;
+        break;
+
+      case 't':
+        //a[ai++] = '\t';
+        //sprintf(a+ai, ".tab.");
+        //ai += strlen(a+ai);
+        a[ai++] = '\t';
+        ti += 2;
+        break;
+
+      default:
+        // XXX TODO what to do??
+        ti += 2;
+        break;
+      }
+    } else if (c >= 0xe0) {
+      //sprintf(a+ai, ".%02x.%02x.%02x.", c, j[ti+1], j[ti+2]);
+      //ai += strlen(a+ai);
+      //ti += 3;
+      a[ai++]=j[ti++];
+      a[ai++]=j[ti++];
+      a[ai++]=j[ti++];
+    } else if (c >= 0xc0) {
+      //sprintf(a+ai, ".%02x.%02x.", c, j[ti+1]);
+      //ai += strlen(a+ai);
+      //ti += 2;
+      a[ai++]=j[ti++];
+      a[ai++]=j[ti++];
+    } else if (c >= 128) {
+      sprintf(a+ai, "-%02x-", c);
+      ai += strlen(a+ai);
+      ti += 1;
+    } else {
+      a[ai++]=j[ti++];
+    }
+  }
+
+  return ai;
+}
+
+// Escape text for a JSON string value (up to 4 output chars per input char)
+static size_t fj_json_escape(char * rr, const char * pptext, size_t pplen)
+{
+  size_t pi=0;
+  size_t ri=0;
+
+  while (pi < pplen) {
+    // NOTE: unsigned to get the same result where char is signed (x86)
+    int pc = (unsigned char)pptext[pi];
+
+    if (pc == '\\') {
+      rr[ri++] = '\\';
+      rr[ri++] = '\\';
+      pi += 1;
+    } else if (pc == '\"') {
+      rr[ri++] = '\\';
+      rr[ri++] = '\"';
+      pi += 1;
+    } else if (pc >= 32 && pc < 127) {
+      rr[ri++] = pptext[pi++];
+    } else if (pc > 0xe0) {
+      //sprintf(rr+ri, ".%02x.%02x.%02x.", pc, pptext[pi+1], pptext[pi+2]);
+      //ri += strlen(rr+ri);
+      //pi += 3;
+      rr[ri++] = pptext[pi++];
+      rr[ri++] = pptext[pi++];
+      rr[ri++] = pptext[pi++];
+    } else if (pc >= 0xc0) {
+      //sprintf(rr+ri, ".%02x.%02x.", pc, pptext[pi+1]);
+      //ri += strlen(rr+ri);
+      //pi += 2;
+      rr[ri++] = pptext[pi++];
+      rr[ri++] = pptext[pi++];
+    } else if (pc >= 128) {
+      // XXX TBD ???:
+      sprintf(rr+ri, "-%02x-", pc);
+      ri += strlen(rr+ri);
+      pi += 1;
+    } else if (pc == '\t') {
+      rr[ri++] = '\\';
+      rr[ri++] = 't';
+      pi += 1;
+    } else if (pc == '\r') {
+      rr[ri++] = '\\';
+      rr[ri++] = 'r';
+      pi += 1;
+    } else if (pc == '\n') {
+      rr[ri++] = '\\';
+      rr[ri++] = 'n';
+      pi += 1;
+    } else {
+      sprintf(rr+ri, "?%02x?", pc);
+      ri += strlen(rr+ri);
+      pi += 1;
+    }
+  }
+
+  return ri;
+}
+
+// Pipelined row encoding (optional):
+// the calling thread steps & copies raw column values into a ring of row batches,
+// an encoder thread escapes them into the result buffer in the same order.
+
+#define FJ_PIPE_SLOTS 4
+#define FJ_PIPE_ROWS 256
+#define FJ_PIPE_SLOT_BYTES 65536
+
+struct fj_pipe_slot {
+  char * buf; // for each column: type byte, then (for non-NULL) int length & text
+  size_t len;
+  size_t alloc;
+  int rows;
+};
+
+struct fj_pipe {
+  pthread_mutex_t m;
+  pthread_cond_t c;
+  struct fj_pipe_slot slot[FJ_PIPE_SLOTS];
+  int head; // next slot to fill
+  int tail; // next slot to encode
+  int filled;
+  bool done; // no more rows
+  bool failed; // memory error in the encoder
+
+  int cc;
+  const char ** names;
+  int * namelens;
+
+  char * rr;
+  size_t rrlen;
+  size_t arlen;
+
+#ifdef SQLC_FJ_STATS
+  sqlc_long_t enc_stats[SQLC_FJ_STAT_COUNT]; // by the encoder thread
+  sqlc_long_t step_stats[SQLC_FJ_STAT_COUNT]; // by the stepping thread
+#endif
+};
+
+// NOTE: uses malloc/memcpy/free instead of realloc (see sqlc_fj_run)
+static bool fj_pipe_grow(struct fj_pipe * p, size_t need)
+{
+  char * old = p->rr;
+
+  if (p->rrlen + need <= p->arlen) return true;
+
+  p->arlen += ((p->rrlen < 1000000) ? p->rrlen : (p->rrlen >> 1)) + need;
+  p->rr = malloc(p->arlen);
+  FJ_STAT_BUF(p->enc_stats, p->arlen, p->rrlen);
+  if (p->rr != NULL) memcpy(p->rr, old, p->rrlen);
+  free(old);
+  return p->rr != NULL;
+}
+
+static bool fj_pipe_encode(struct fj_pipe * p, const struct fj_pipe_slot * sl)
+{
+  const char * b = sl->buf;
+  int ri, jj;
+  char nf[22];
+
+  sprintf(nf, "%d,", p->cc);
+
+  for (ri=0; ri<sl->rows; ++ri) {
+    // leave room for "endrows" etc. after the last row:
+    if (!fj_pipe_grow(p, 200)) return false;
+    strcpy(p->rr+p->rrlen, nf);
+    p->rrlen += strlen(nf);
+
+    for (jj=0; jj<p->cc; ++jj) {
+      int ct = *b++;
+      int vl = 0;
+
+      if (ct != SQLITE_NULL) {
+        memcpy(&vl, b, sizeof(int));
+        b += sizeof(int);
+      }
+
+      if (!fj_pipe_grow(p, p->namelens[jj] + 4*(size_t)vl + 200)) return false;
+
+      p->rr[p->rrlen++] = '\"';
+      memcpy(p->rr+p->rrlen, p->names[jj], p->namelens[jj]);
+      p->rrlen += p->namelens[jj];
+      strcpy(p->rr+p->rrlen, "\",");
+      p->rrlen += 2;
+
+      if (ct == SQLITE_NULL) {
+        strcpy(p->rr+p->rrlen, "null,");
+        p->rrlen += 5;
+      } else if (ct == SQLITE_INTEGER || ct == SQLITE_FLOAT) {
+        memcpy(p->rr+p->rrlen, b, vl);
+        p->rrlen += vl;
+        p->rr[p->rrlen++] = ',';
+      } else {
+        p->rr[p->rrlen++] = '\"';
+        p->rrlen += fj_json_escape(p->rr+p->rrlen, b, vl);
+        strcpy(p->rr+p->rrlen, "\",");
+        p->rrlen += 2;
+      }
+      b += vl;
+    }
+  }
+
+  return true;
+}
+
+static void * fj_pipe_encoder(void * arg)
+{
+  struct fj_pipe * p = arg;
+
+  pthread_mutex_lock(&p->m);
+  for (;;) {
+    struct fj_pipe_slot * sl;
+    bool ok;
+
+    while (p->filled == 0 && !p->done) pthread_cond_wait(&p->c, &p->m);
+    if (p->filled == 0) break;
+
+    sl = &p->slot[p->tail];
+    pthread_mutex_unlock(&p->m);
+
+    ok = fj_pipe_encode(p, sl);
+
+    pthread_mutex_lock(&p->m);
+    sl->len = 0;
+    sl->rows = 0;
+    p->tail = (p->tail + 1) % FJ_PIPE_SLOTS;
+    --p->filled;
+    if (!ok) p->failed = true;
+    pthread_cond_broadcast(&p->c);
+    if (!ok) break;
+  }
+  pthread_mutex_unlock(&p->m);
+
+  return NULL;
+}
+
+// Add the current row of s to the slot being filled:
+static bool fj_pipe_copy_row(struct fj_pipe * p, sqlite3_stmt * s)
+{
+  struct fj_pipe_slot * sl = &p->slot[p->head];
+  int jj;
+
+  for (jj=0; jj<p->cc; ++jj) {
+    int ct = sqlite3_column_type(s, jj);
+    const char * v = NULL;
+    int vl = 0;
+
+    if (ct != SQLITE_NULL) {
+      // NOTE: up to the first NUL, same as the sequential path
+      v = (const char *)sqlite3_column_text(s, jj);
+      vl = (v == NULL) ? 0 : strlen(v);
+    }
+
+    if (sl->len + 1 + sizeof(int) + vl > sl->alloc) {
+      size_t na = sl->alloc + sl->alloc + 1 + sizeof(int) + vl;
+      char * nb = malloc(na);
+      FJ_STAT_ALLOC(p->step_stats, na);
+      if (nb == NULL) return false;
+      if (sl->len > 0) memcpy(nb, sl->buf, sl->len);
+      free(sl->buf);
+      sl->buf = nb;
+      sl->alloc = na;
+    }
+
+    sl->buf[sl->len++] = ct;
+    if (ct != SQLITE_NULL) {
+      memcpy(sl->buf+sl->len, &vl, sizeof(int));
+      sl->len += sizeof(int);
+      memcpy(sl->buf+sl->len, v, vl);
+      sl->len += vl;
+    }
+  }
+
+  ++sl->rows;
+  return true;
+}
+
+// Step through the remaining rows of s (already on the first row) & encode them
+// after rr (may be reallocated, NULL in case of memory error). Returns the last step result.
+static int fj_pipe_rows(struct fj_s * myfj, sqlite3_stmt * s, char ** rr, size_t * rrlen, size_t * arlen)
+{
+  struct fj_pipe p;
+  pthread_t th;
+  bool started = false;
+  bool ok = true;
+  int rv = SQLITE_ROW;
+  int jj;
+
+  memset(&p, 0, sizeof(p));
+  pthread_mutex_init(&p.m, NULL);
+  pthread_cond_init(&p.c, NULL);
+  p.rr = *rr;
+  p.rrlen = *rrlen;
+  p.arlen = *arlen;
+
+  // copy column names, since the encoder thread must not call sqlite:
+  p.cc = sqlite3_column_count(s);
+  p.names = malloc(p.cc * sizeof(char *));
+  p.namelens = malloc(p.cc * sizeof(int));
+  if (p.names == NULL || p.namelens == NULL) ok = false;
+  for (jj=0; ok && jj<p.cc; ++jj) {
+    const char * n = sqlite3_column_name(s, jj);
+    p.namelens[jj] = strlen(n);
+    p.names[jj] = malloc(p.namelens[jj] + 1);
+    if (p.names[jj] == NULL) { p.cc = jj; ok = false; break; }
+    strcpy((char *)p.names[jj], n);
+  }
+
+  while (ok && rv == SQLITE_ROW) {
+    struct fj_pipe_slot * sl = &p.slot[p.head];
+
+    if (!fj_pipe_copy_row(&p, s)) ok = false;
+
+    rv = sqlite3_step(s);
+
+    if (ok && (sl->rows >= FJ_PIPE_ROWS || sl->len >= FJ_PIPE_SLOT_BYTES || rv != SQLITE_ROW)) {
+      pthread_mutex_lock(&p.m);
+      p.head = (p.head + 1) % FJ_PIPE_SLOTS;
+      ++p.filled;
+      pthread_cond_broadcast(&p.c);
+      // back-pressure: wait for a free slot
+      while (started && p.filled == FJ_PIPE_SLOTS && !p.failed) pthread_cond_wait(&p.c, &p.m);
+      if (p.failed) ok = false;
+      pthread_mutex_unlock(&p.m);
+
+      // start the encoder thread only for a result bigger than one slot:
+      if (ok && !started && rv == SQLITE_ROW) {
+        if (pthread_create(&th, NULL, fj_pipe_encoder, &p) == 0) started = true;
+        else {
+          // encode in this thread instead:
+          if (!fj_pipe_encode(&p, &p.slot[p.tail])) ok = false;
+          p.slot[p.tail].len = p.slot[p.tail].rows = 0;
+          p.tail = (p.tail + 1) % FJ_PIPE_SLOTS;
+          --p.filled;
+        }
+      }
+    }
+  }
+
+  pthread_mutex_lock(&p.m);
+  p.done = true;
+  pthread_cond_broadcast(&p.c);
+  pthread_mutex_unlock(&p.m);
+
+  if (started) pthread_join(th, NULL);
+  else if (ok) fj_pipe_encoder(&p); // encode what is left in this thread
+
+  if (p.failed) ok = false;
+
+#ifdef SQLC_FJ_STATS
+  fj_stat_merge(myfj->stats, p.enc_stats);
+  fj_stat_merge(myfj->stats, p.step_stats);
+#endif
+
+  for (jj=0; jj<FJ_PIPE_SLOTS; ++jj) free(p.slot[jj].buf);
+  for (jj=0; p.names != NULL && jj<p.cc; ++jj) free((char *)p.names[jj]);
+  free(p.names);
+  free(p.namelens);
+  pthread_mutex_destroy(&p.m);
+  pthread_cond_destroy(&p.c);
+
+  if (!ok) {
+    free(p.rr);
+    p.rr = NULL;
+  }
+
+  *rr = p.rr;
+  *rrlen = p.rrlen;
+  *arlen = p.arlen;
+  return rv;
+}
+
+static const char *fj_run(sqlc_handle_t fj, const char *batch_json, int ll)
+{
+// XXX MAJOR TODO(s)
+// handle constraint violation
+// extra json char issue(s)
+// basic optimization(s)
+//
+// DOUBLE-CHECK:
+// deal with json char issues
+// check return values
+// error handling
+// bind args
+// deal with numbers, true/false, null, etc. etc. etc.
+// rowsAffected/insertId
+// opt keep track of result json position
+// double-check for possible memory overflows
+
+  struct fj_s * myfj = HANDLE_TO_VP(fj);
+  sqlite3 *mydb = myfj->mydb;
+
+  jsmn_parser myparser;
+  jsmntok_t *tokn = NULL;
+  int r = -1;
+
+  int as = 0;
+  int flen = 0;
+  char nf[22];
+  int nflen = 0;
+
+  int fi = 0;
+  sqlite3_stmt *s = NULL;
+  int rv = -1;
+  int jj, cc;
+  int param_count = 0;
+  int bi = 0;
+
+  bool reg = false;
+
+  const char * ck = NULL;
+  unsigned int ch = 0;
+  size_t ckl = 0;
+  size_t frag0 = 0;
+  const char * formaterror = NULL;
+
+  // FUTURE TBD optimize?
+  // For alloc memory test:
+  //const FIRST_ALLOC = 40;
+  // Desired for normal situations:
+  //const FIRST_ALLOC = 1000;
+  // XXX TBD NEEDED to pass big memory test:
+  const FIRST_ALLOC = 10000;
+  const NEXT_ALLOC = 80; // extra extra padding extra extra padding
+
+  char * rr;
+  size_t rrlen = 0;
+  size_t arlen = 0;
+  const char * pptext = 0;
+  size_t pplen = 0;
+
+// Double alloc every time:
+//#define EXTRA_ALLOC rrlen
+// Extra half alloc every time:
+//#define EXTRA_ALLOC (rrlen >> 1)
+// Hybrid double/extra half alloc every time (seems best for bulk scenarios):
+#define EXTRA_ALLOC ((rrlen < 1000000) ? rrlen : (rrlen >> 1))
+//#define EXTRA_ALLOC ((rrlen < 1000000) ? 1000000 : (rrlen >> 1))
+// Don't double or extra half alloc every time (for extra alloc memory test):
+//#define EXTRA_ALLOC 11
+
+// EXTRA NOTE: Use of realloc seems to break under some bulk scenarios.
+// WORKAROUND is to do malloc/memcpy/free instead.
+// TBD VERY strange!
+
+  free(myfj->cleanup1);
+  myfj->cleanup1 = NULL;
+  free(myfj->cleanup2);
+  myfj->cleanup2 = NULL;
+
+#ifdef SQLC_FJ_STATS
+  myfj->stats[SQLC_FJ_STAT_RUN_ALLOCS] = 0;
+  myfj->stats[SQLC_FJ_STAT_RUN_BYTES] = 0;
+  myfj->stats[SQLC_FJ_STAT_RUN_COPIED] = 0;
+  myfj->stats[SQLC_FJ_STAT_RUN_PEAK] = 0;
+#endif
+
+  //tokn = tokns;
+  myfj->cleanup1 = tokn = malloc(ll*sizeof(jsmntok_t));
+  FJ_STAT_ALLOC(myfj->stats, ll*sizeof(jsmntok_t));
+
+  if (tokn == NULL) goto batchmemoryerror;
+
+  jsmn_init(&myparser);
+  r = jsmn_parse(&myparser, batch_json, strlen(batch_json), tokn, ll);
+  if (r < 0) return "{\"message\": \"jsmn_parse error 1\"}";
+
+  // FUTURE TBD check for tok overflow?
+  //if (i >= r) return "{\"message\": \"memory error 1\"}";
+
+  if (tokn->type != JSMN_ARRAY) return "{\"message\": \"missing array 1\"}";
+  as = tokn->size;
+  ++tokn;
+
+#if 0
+  if (tokn->type != JSMN_OBJECT) return "{\"message\": \"missing object 1\"}";
+  ++tokn;
+
+  // dbargs (ignored)
+  if (tokn->type != JSMN_STRING) return "{\"message\": \"type error 1\"}";
+  if (strncmp(batch_json+tokn->start, "dbargs", 6) != 0)
+    return "{\"message\": \"arg error 1\"}";
+  ++tokn;
+
+  if (tokn->type != JSMN_OBJECT) return "{\"message\": \"type error 2\"}";
+  tokn = tokn + (tokn->size << 1);
+  ++tokn;
+
+  // flen
+  if (tokn->type != JSMN_STRING) return "{\"message\": \"type error 3\"}";
+  if (strncmp(batch_json+tokn->start, "flen", 4) != 0)
+    return "{\"message\": \"arg error 2\"}";
+  ++tokn;
+  if (tokn->type != JSMN_PRIMITIVE) return "{\"message\": \"type error 4\"}";
+  nflen = tokn->end-tokn->start;
+  strncpy(nf, batch_json+tokn->start, nflen);
+  nf[nflen] = '\0';
+  flen = atoi(nf);
+  ++tokn;
+
+  // flatlist
+  if (tokn->type != JSMN_STRING) return "{\"message\": \"type error 5\"}";
+  if (strncmp(batch_json+tokn->start, "flatlist", 8) != 0)
+    return "{\"message\": \"arg error 3\"}";
+  ++tokn;
+  if (tokn->type != JSMN_ARRAY) return "{\"message\": \"type error 6\"}";
+  // TODO get flatlist length
+  ++tokn;
+#endif
+
+#if 1
+  // dbid
+  if (tokn->type != JSMN_PRIMITIVE) return "{\"message\": \"type error 4\"}";
+  ++tokn;
+
+  // flen (batch length)
+  if (tokn->type != JSMN_PRIMITIVE) return "{\"message\": \"type error 4a\"}";
+  nflen = tokn->end-tokn->start;
+  strncpy(nf, batch_json+tokn->start, nflen);
+  nf[nflen] = '\0';
+  flen = atoi(nf);
+  ++tokn;
+#endif
+
+  // not needed here:
+  // "check" first SQL (or registered statement ID):
+  if (tokn->type != JSMN_STRING && tokn->type != JSMN_PRIMITIVE) return "{\"message\": \"type error 7\"}";
+
+  myfj->cleanup2 = rr = malloc(arlen = FIRST_ALLOC);
+  FJ_STAT_BUF(myfj->stats, arlen, 0);
+  if (rr == NULL) goto batchmemoryerror;
+
+  strcpy(rr, "[");
+  rrlen = 1;
+
+  if (myfj->budget_ms > 0 || myfj->budget_steps > 0) {
+    myfj->steps = 0;
+    myfj->deadline = fj_now_ms() + myfj->budget_ms;
+    sqlite3_progress_handler(mydb, FJ_PROGRESS_OPS, fj_progress, myfj);
+  }
+
+  if (myfj->cache != NULL) fj_cache_begin(mydb, myfj->cache);
+
+  for (fi=0; fi<flen; ++fi) {
+    sqlite3_int64 tc0 = sqlite3_total_changes64(mydb);
+
+    // stop before the next statement if out of time:
+    if (myfj->budget_ms > 0 && fj_now_ms() >= myfj->deadline) break;
+
+    //if (tokn->type != JSMN_STRING) return "{\"message\": \"type error (sql)\"}";
+    //if (tokn->type != JSMN_STRING && tokn->type != JSMN_PRIMITIVE) return "{\"message\": \"type error (sql)\"}";
+    if (tokn->type != JSMN_STRING && tokn->type != JSMN_PRIMITIVE) {
+      formaterror = batch_json+tokn->start;
+      goto batchformaterror;
+    }
+
+    ckl = 0;
+    if (myfj->cache != NULL && tokn[1].type == JSMN_PRIMITIVE) {
+      int kpc = -1; // (not cached if too long for a number)
+      struct fj_cache_entry * e;
+
+      nflen = tokn[1].end-tokn[1].start;
+      if (nflen < sizeof(nf)) {
+        strncpy(nf, batch_json+tokn[1].start, nflen);
+        nf[nflen] = '\0';
+        kpc = atoi(nf);
+      }
+
+      // key: raw JSON from the SQL through the last parameter
+      if (kpc >= 0 && (tokn - (jsmntok_t *)myfj->cleanup1) + 1 + kpc < r) {
+        ck = batch_json+tokn->start;
+        ckl = tokn[1+kpc].end - tokn->start;
+        ch = fj_cache_hash(ck, ckl);
+        e = fj_cache_find(myfj->cache, ch, ck, ckl);
+        if (e != NULL) {
+          if (rrlen + e->vallen + 200 > arlen) {
+            char * old = rr;
+            arlen += EXTRA_ALLOC + e->vallen + 200 + 50;
+            myfj->cleanup2 = rr = malloc(arlen);
+            FJ_STAT_BUF(myfj->stats, arlen, rrlen);
+            if (rr != NULL) memcpy(rr, old, rrlen);
+            free(old);
+            if (rr == NULL) goto batchmemoryerror;
+          }
+          memcpy(rr+rrlen, e->data+e->keylen, e->vallen);
+          rrlen += e->vallen;
+          tokn += 2 + kpc;
+          continue;
+        }
+      }
+    }
+    frag0 = rrlen;
+
+    reg = (tokn->type == JSMN_PRIMITIVE);
+    if (reg) {
+      // registered statement ID:
+      int id = 0;
+      nflen = tokn->end-tokn->start;
+      if (nflen < sizeof(nf)) {
+        strncpy(nf, batch_json+tokn->start, nflen);
+        nf[nflen] = '\0';
+        id = atoi(nf);
+      }
+      if (id < 1 || id > myfj->reg_count) {
+        s = NULL;
+        rv = SQLITE_MISUSE;
+      } else {
+        s = myfj->reg_st[id-1];
+        rv = SQLITE_OK;
+      }
+    } else
+    //rv = sqlite3_prepare_v2(mydb, batch_json+tokn->start, tokn->end-tokn->start, &s, NULL);
+    {
+      // XXX FUTURE TBD keep buffer & free at the end
+      size_t tl = tokn->end-tokn->start;
+      char * a = malloc(tl+100); // extra padding
+      FJ_STAT_ALLOC(myfj->stats, tl+100);
+      size_t ai = (a == NULL) ? 0 : sj(batch_json+tokn->start, tl, a);
+      if (a == NULL) goto batchmemoryerror;
+      if (ai > INT_MAX) {
+        s = NULL;
+        rv = SQLITE_TOOBIG;
+      } else {
+        rv = sqlite3_prepare_v2(mydb, a, (int)ai, &s, NULL);
+      }
+      free(a);
+    }
+    ++tokn;
+    // TODO check rv
+
+    // TODO deal with bind count
+    //if (tokn->type != JSMN_PRIMITIVE) return "{\"message\": \"xxxx\"}";
+    //if (tokn->type != JSMN_PRIMITIVE) return batch_json+tokn->start;
+    if (tokn->type != JSMN_PRIMITIVE) {
+      formaterror = "{\"message\": \"xxxx\"}";
+      goto batchformaterror1;
+    }
+    nflen = tokn->end-tokn->start;
+    strncpy(nf, batch_json+tokn->start, nflen);
+    nf[nflen] = '\0';
+    param_count = atoi(nf);
+    ++tokn;
+
+    //tokn = tokn + param_count;// XXX TEMP TEST
+
+    // XXX TODO OVERFLOW ETC ETC
+
+    if (rv != SQLITE_OK) {
+      tokn = tokn + param_count;
+    } else {
+      for (bi=1; bi<=param_count; ++bi) {
+        // XXX TODO deal with BLOB etc etc
+        // XXX TBD/TODO check bind result??
+        if (tokn->type == JSMN_PRIMITIVE) {
+          // XXX TODO double-check:
+          // XXX TODO TEST ALL:
+          if (batch_json[tokn->start] == 'n') {
+            sqlite3_bind_null(s, bi);
+          } else if (batch_json[tokn->start] == 't') {
+            sqlite3_bind_int(s, bi, 1);
+          } else if (batch_json[tokn->start] == 'f') {
+            sqlite3_bind_int(s, bi, 0);
+          } else {
+            bool f=false;
+            ptrdiff_t iii;
+
+            for (iii=tokn->start; iii!=tokn->end; ++iii) {
+              if (batch_json[iii]=='.') {
+                f = true;
+                break;
+              }
+            }
+
+            nflen = tokn->end-tokn->start;
+            strncpy(nf, batch_json+tokn->start, nflen);
+            nf[nflen] = '\0';
+
+            if (f) {
+              sqlite3_bind_double(s, bi, atof(nf));
+            } else {
+              sqlite3_bind_int64(s, bi, atoll(nf));
+            }
+          }
+        } else {
+          // XXX FUTURE TBD keep buffer & free at the end
+          //sqlite3_bind_text(s, bi, batch_json+tokn->start, tokn->end-tokn->start, SQLITE_TRANSIENT);
+          size_t tl = tokn->end-tokn->start;
+          char * a = malloc(tl+100); // extra padding
+          FJ_STAT_ALLOC(myfj->stats, tl+100);
+          size_t ai = (a==NULL) ? 0 : sj(batch_json+tokn->start, tl, a);
+          if (a == NULL) goto batchmemoryerror1;
+          sqlite3_bind_text64(s, bi, a, ai, SQLITE_TRANSIENT, SQLITE_UTF8);
+          free(a);
+        }
+        ++tokn;
+      }
+
+      rv=sqlite3_step(s);
+      if (rv == SQLITE_ROW && myfj->pipeline) {
+        strcpy(rr+rrlen, "\"okrows\",");
+        rrlen += 9;
+        rv = fj_pipe_rows(myfj, s, &rr, &rrlen, &arlen);
+        myfj->cleanup2 = rr;
+        if (rr == NULL) goto batchmemoryerror1;
+        strcpy(rr+rrlen, "\"endrows\",");
+        rrlen += 10;
+      } else if (rv == SQLITE_ROW) {
+        strcpy(rr+rrlen, "\"okrows\",");
+        rrlen += 9;
+        do {
+          cc = sqlite3_column_count(s);
+          sprintf(nf, "%d", cc);
+          strcpy(rr+rrlen, nf);
+          rrlen += strlen(nf);
+          strcpy(rr+rrlen, ",");
+          ++rrlen;
+
+          for (jj=0; jj<cc; ++jj) {
+            int ct = sqlite3_column_type(s, jj);
+
+            strcpy(rr+rrlen, "\"");
+            rrlen += 1;
+            pptext = sqlite3_column_name(s, jj);
+            pplen = strlen(pptext);
+            if (rrlen + pplen + NEXT_ALLOC > arlen) {
+              char * old = rr;
+              arlen += EXTRA_ALLOC + pplen + NEXT_ALLOC;
+              //myfj->cleanup2 = rr = realloc(rr, arlen);
+              myfj->cleanup2 = rr = malloc(arlen);
+              FJ_STAT_BUF(myfj->stats, arlen, rrlen);
+              if (rr != NULL) memcpy(rr, old, rrlen);
+              free(old);
+              if (rr == NULL) goto batchmemoryerror1;
+            }
+            strcpy(rr+rrlen, pptext);
+            rrlen += pplen;
+            strcpy(rr+rrlen, "\",");
+            rrlen += 2;
+
+            if (ct == SQLITE_NULL) {
+              // XXX TODO TEST ME
+              strcpy(rr+rrlen, "null,");
+              rrlen += 5;
+            } else {
+              pptext = sqlite3_column_text(s, jj);
+              pplen = strlen(pptext);
+              //pplen = 0;
+              //while(pptext[pplen] != 0) ++pplen;
+
+              // NOTE: up to 4 chars per input char for JSON encoding (fj_json_escape)
+              if (rrlen + 4*pplen + NEXT_ALLOC > arlen) {
+                char * old = rr;
+                arlen += EXTRA_ALLOC + 4*pplen + NEXT_ALLOC;
+                //myfj->cleanup2 = rr = realloc(rr, arlen);
+                myfj->cleanup2 = rr = malloc(arlen);
+                FJ_STAT_BUF(myfj->stats, arlen, rrlen);
+                if (rr != NULL) memcpy(rr, old, rrlen);
+                free(old);
+                if (rr == NULL) goto batchmemoryerror1;
+              }
+
+              if (ct == SQLITE_INTEGER || ct == SQLITE_FLOAT) {
+                strcpy(rr+rrlen, pptext);
+                rrlen += pplen;
+                strcpy(rr+rrlen, ",");
+                rrlen += 1;
+              } else {
+                // XXX FUTURE TODO handle BLOB correctly
+                // XXX TBD CHECK PROPER JSON ??
+                strcpy(rr+rrlen, "\"");
+                rrlen += 1;
+                //strcpy(rr+rrlen, pptext);
+                //rrlen += pplen;
+                rrlen += fj_json_escape(rr+rrlen, pptext, pplen);
+                strcpy(rr+rrlen, "\",");
+                rrlen += 2;
+              }
+            }
+          }
+          rv=sqlite3_step(s);
+        } while (rv == SQLITE_ROW);
+        strcpy(rr+rrlen, "\"endrows\",");
+        rrlen += 10;
+      } else if (rv == SQLITE_OK || rv == SQLITE_DONE) {
+        sqlite3_int64 rowsAffected = sqlite3_total_changes64(mydb) - tc0;
+
+        //if (rrlen + 40 + NEXT_ALLOC > arlen)
+        if (rrlen + 200 > arlen) {
+          char * old = rr;
+          //arlen += EXTRA_ALLOC + 40 + NEXT_ALLOC;
+          arlen += EXTRA_ALLOC + 200 + 50;
+          //myfj->cleanup2 = rr = realloc(rr, arlen);
+          myfj->cleanup2 = rr = malloc(arlen);
+          FJ_STAT_BUF(myfj->stats, arlen, rrlen);
+          if (rr != NULL) memcpy(rr, old, rrlen);
+          free(old);
+          if (rr == NULL) goto batchmemoryerror1;
+        }
+
+        if (rowsAffected > 0) {
+          sqlite3_int64 insertId = sqlite3_last_insert_rowid(mydb);
+
+          strcpy(rr+rrlen, "\"ch2\",");
+          rrlen += 6;
+
+          sprintf(nf, "%lld", (long long)rowsAffected);
+          strcpy(rr+rrlen, nf);
+          rrlen += strlen(nf);
+          strcpy(rr+rrlen, ",");
+          ++rrlen;
+
+          sprintf(nf, "%lld", (long long)insertId);
+          strcpy(rr+rrlen, nf);
+          rrlen += strlen(nf);
+          strcpy(rr+rrlen, ",");
+          ++rrlen;
+        } else {
+          strcpy(rr+rrlen, "\"ok\",");
+          rrlen += 5;
+        }
+      }
+    }
+
+    if (rv == SQLITE_INTERRUPT) {
+      // stop here, with statement fi reported as not completed:
+      FJ_RELEASE_ST(s, reg);
+      break;
+    }
+
+    if (rv != SQLITE_OK && rv != SQLITE_DONE) {
+      if (rrlen + 200 > arlen) {
+        char * old = rr;
+        //arlen += EXTRA_ALLOC + 40 + NEXT_ALLOC;
+        arlen += EXTRA_ALLOC + 200 + 50;
+        //myfj->cleanup2 = rr = realloc(rr, arlen);
+        myfj->cleanup2 = rr = malloc(arlen);
+        FJ_STAT_BUF(myfj->stats, arlen, rrlen);
+        if (rr != NULL) memcpy(rr, old, rrlen);
+        free(old);
+        if (rr == NULL) goto batchmemoryerror1;
+      }
+
+      // XXX TODO REPORT CORRECT ERROR
+      strcpy(rr+rrlen, "\"error\",0,1,\"--\",");
+      rrlen += 17;
+    }
+
+    if (myfj->cache != NULL && s != NULL) {
+      if (!sqlite3_stmt_readonly(s)) {
+        // possible write: drop the cache & add nothing more during this run
+        fj_cache_clear(myfj->cache);
+        myfj->cache->frozen = true;
+      } else if (ckl > 0 && rv == SQLITE_DONE && sqlite3_column_count(s) > 0 && sqlite3_get_autocommit(mydb)) {
+        // NOTE: results read within an explicit transaction are not cached, in case of rollback
+        fj_cache_put(myfj->cache, ch, ck, ckl, rr+frag0, rrlen-frag0);
+      }
+    }
+
+    // FUTURE TODO what to do in case this returns an error
+    FJ_RELEASE_ST(s, reg);
+
+#if 0 // NO NEEDED BEFORE ADDING SQL STATEMENT RESULT
+    // TODO explain why:
+    if (rrlen + 40 + NEXT_ALLOC > arlen) {
+      //arlen += EXTRA_ALLOC + 40 + NEXT_ALLOC;
+      arlen = arlen + arlen + rrlen + 200;
+      myfj->cleanup2 = rr = realloc(rr, arlen);
+      if (rr == NULL) goto batchmemoryerror1;
+    }
+#endif
+  }
+
+  if (myfj->budget_ms > 0 || myfj->budget_steps > 0)
+    sqlite3_progress_handler(mydb, 0, NULL, NULL);
+
+  if (fi < flen) {
+    if (rrlen + 200 > arlen) {
+      char * old = rr;
+      arlen += EXTRA_ALLOC + 200 + 50;
+      myfj->cleanup2 = rr = malloc(arlen);
+      FJ_STAT_BUF(myfj->stats, arlen, rrlen);
+      if (rr != NULL) memcpy(rr, old, rrlen);
+      free(old);
+      if (rr == NULL) goto batchmemoryerror;
+    }
+
+    strcpy(rr+rrlen, "\"interrupted\",");
+    rrlen += 14;
+    sprintf(nf, "%d", fi);
+    strcpy(rr+rrlen, nf);
+    rrlen += strlen(nf);
+    strcpy(rr+rrlen, ",");
+    ++rrlen;
+  }
+
+  strcpy(rr+rrlen, "\"bogus\"]");
+
+  return rr;
+
+batchmemoryerror1:
+  // FUTURE TODO what to do in case this returns an error
+  FJ_RELEASE_ST(s, reg);
+
+batchmemoryerror:
+  if (myfj->budget_ms > 0 || myfj->budget_steps > 0)
+    sqlite3_progress_handler(mydb, 0, NULL, NULL);
+
+  free(myfj->cleanup1);
+  myfj->cleanup1 = NULL;
+  free(myfj->cleanup2);
+  myfj->cleanup2 = NULL;
+
+  return "[\"batcherror\", \"memory error\", \"bogus\"]";
+
+batchformaterror1:
+  FJ_RELEASE_ST(s, reg);
+
+batchformaterror:
+  // (the budget deadline would otherwise interrupt every later statement on the db)
+  if (myfj->budget_ms > 0 || myfj->budget_steps > 0)
+    sqlite3_progress_handler(mydb, 0, NULL, NULL);
+
+  return formaterror;
+}
+
+const char *sqlc_fj_run(sqlc_handle_t fj, const char *batch_json, int ll)
+{
+  struct fj_s * myfj = HANDLE_TO_VP(fj);
+  const char * rr;
+
+  // (not trimmed while running)
+  pthread_mutex_lock(&fj_list_mutex);
+  myfj->busy = true;
+  pthread_mutex_unlock(&fj_list_mutex);
+
+  rr = fj_run(fj, batch_json, ll);
+
+  pthread_mutex_lock(&fj_list_mutex);
+  myfj->busy = false;
+  pthread_mutex_unlock(&fj_list_mutex);
+
+  return rr;
+}
+
+// Export & import through a fixed-size buffer (memory use independent of the data size):
+
+#define SQLC_IO_BUF_SIZE 65536
+// input text is escaped in slices of this size (up to 4 output chars per input char):
+#define SQLC_IO_ESC_SLICE 4096
+
+struct sqlc_out {
+  int fd;
+  bool err;
+  sqlc_long_t bytes;
+  size_t len;
+  char buf[SQLC_IO_BUF_SIZE];
+};
+
+static void sqlc_out_flush(struct sqlc_out * o)
+{
+  size_t off = 0;
+
+  while (off < o->len && !o->err) {
+    ssize_t w = write(o->fd, o->buf+off, o->len-off);
+    if (w < 0 && errno == EINTR) continue;
+    if (w <= 0) o->err = true;
+    else off += w;
+  }
+
+  o->bytes += off;
+  o->len = 0;
+}
+
+static void sqlc_out_put(struct sqlc_out * o, const char * p, size_t n)
+{
+  while (n > 0 && !o->err) {
+    size_t k = SQLC_IO_BUF_SIZE - o->len;
+    if (k == 0) {
+      sqlc_out_flush(o);
+      continue;
+    }
+    if (k > n) k = n;
+    memcpy(o->buf+o->len, p, k);
+    o->len += k;
+    p += k;
+    n -= k;
+  }
+}
+
+// JSON string value, escaped the same way as in a sqlc_fj_run() result
+static void sqlc_out_json_string(struct sqlc_out * o, const char * p, size_t n)
+{
+  sqlc_out_put(o, "\"", 1);
+
+  while (n > 0 && !o->err) {
+    size_t k = (n > SQLC_IO_ESC_SLICE) ? SQLC_IO_ESC_SLICE : n;
+
+    // keep each UTF-8 sequence within one slice:
+    while (k < n && k > 1 && ((unsigned char)p[k] & 0xc0) == 0x80) --k;
+
+    // (+1 for the terminator that may be written by sprintf)
+    if (SQLC_IO_BUF_SIZE - o->len < 4*k + 1) sqlc_out_flush(o);
+    if (o->err) return;
+    o->len += fj_json_escape(o->buf+o->len, p, k);
+    p += k;
+    n -= k;
+  }
+
+  sqlc_out_put(o, "\"", 1);
+}
+
+// CSV field (RFC 4180), quoted only if needed
+static void sqlc_out_csv_field(struct sqlc_out * o, const char * p, size_t n)
+{
+  size_t i;
+
+  for (i=0; i<n; ++i)
+    if (p[i] == ',' || p[i] == '\"' || p[i] == '\r' || p[i] == '\n') break;
+
+  if (i == n) {
+    sqlc_out_put(o, p, n);
+    return;
+  }
+
+  sqlc_out_put(o, "\"", 1);
+  while (n > 0) {
+    const char * q = memchr(p, '\"', n);
+    size_t k = (q == NULL) ? n : (size_t)(q - p) + 1;
+    sqlc_out_put(o, p, k);
+    if (q != NULL) sqlc_out_put(o, "\"", 1);
+    p += k;
+    n -= k;
+  }
+  sqlc_out_put(o, "\"", 1);
+}
+
+// Bind a JSON string, number, true/false or null (same as a sqlc_fj_run() parameter),
+// a nested array or object is bound as its JSON text
+static int sqlc_bind_json_value(sqlite3_stmt * s, int bi, const char * json, const jsmntok_t * tokn)
+{
+  if (tokn->type == JSMN_ARRAY || tokn->type == JSMN_OBJECT) {
+    return sqlite3_bind_text64(s, bi, json+tokn->start, tokn->end - tokn->start, SQLITE_TRANSIENT, SQLITE_UTF8);
+  } else if (tokn->type == JSMN_PRIMITIVE) {
+    char nf[40];
+    size_t nflen = tokn->end - tokn->start;
+
+    if (json[tokn->start] == 'n') return sqlite3_bind_null(s, bi);
+    if (json[tokn->start] == 't') return sqlite3_bind_int(s, bi, 1);
+    if (json[tokn->start] == 'f') return sqlite3_bind_int(s, bi, 0);
+
+    if (nflen >= sizeof(nf)) return SQLITE_MISMATCH;
+    memcpy(nf, json+tokn->start, nflen);
+    nf[nflen] = '\0';
+
+    if (strpbrk(nf, ".eE") != NULL) return sqlite3_bind_double(s, bi, atof(nf));
+    return sqlite3_bind_int64(s, bi, atoll(nf));
+  } else {
+    size_t tl = tokn->end - tokn->start;
+    char * a = malloc(tl+100); // extra padding
+    size_t ai;
+    int rv;
+
+    if (a == NULL) return SQLITE_NOMEM;
+    ai = sj(json+tokn->start, tl, a);
+    rv = sqlite3_bind_text64(s, bi, a, ai, SQLITE_TRANSIENT, SQLITE_UTF8);
+    free(a);
+    return rv;
+  }
+}
+
+// Bind the values of a flat JSON array (NULL or empty for no parameters)
+static int sqlc_bind_json_array(sqlite3_stmt * s, const char * json)
+{
+  jsmn_parser myparser;
+  jsmntok_t * tokn;
+  size_t jl;
+  int r, bi;
+  int rv = SQLITE_OK;
+
+  if (json == NULL || json[0] == '\0') return SQLITE_OK;
+
+  jl = strlen(json);
+  jsmn_init(&myparser);
+  r = jsmn_parse(&myparser, json, jl, NULL, 0);
+  if (r < 1) return SQLITE_MISUSE;
+
+  tokn = malloc(r * sizeof(jsmntok_t));
+  if (tokn == NULL) return SQLITE_NOMEM;
+
+  jsmn_init(&myparser);
+  if (jsmn_parse(&myparser, json, jl, tokn, r) != r ||
+      tokn[0].type != JSMN_ARRAY || tokn[0].size != r-1) {
+    rv = SQLITE_MISUSE;
+  } else {
+    for (bi=1; bi<r && rv == SQLITE_OK; ++bi)
+      rv = sqlc_bind_json_value(s, bi, json, &tokn[bi]);
+  }
+
+  free(tokn);
+  return rv;
+}
+
+int sqlc_db_export(sqlc_handle_t db, const char *sql, const char *params, const char *path, int format, void *stats, int len)
+{
+  sqlite3 *mydb = HANDLE_TO_VP(db);
+  sqlite3_stmt *s = NULL;
+  struct sqlc_out *o;
+  sqlc_long_t v[SQLC_EXPORT_STAT_COUNT] = { 0, 0 };
+  int n = len / sizeof(sqlc_long_t);
+  int rv, cc, jj;
+
+  MYLOG("%s %p %s %d", __func__, mydb, path, format);
+
+  if (format != SQLC_EXPORT_NDJSON && format != SQLC_EXPORT_CSV) return SQLITE_MISUSE;
+  if (n > SQLC_EXPORT_STAT_COUNT) n = SQLC_EXPORT_STAT_COUNT;
+
+  rv = sqlite3_prepare_v2(mydb, sql, -1, &s, NULL);
+  if (rv != SQLITE_OK) return rv;
+
+  rv = sqlc_bind_json_array(s, params);
+  o = (rv == SQLITE_OK) ? malloc(sizeof(struct sqlc_out)) : NULL;
+  if (o == NULL) {
+    sqlite3_finalize(s);
+    return (rv == SQLITE_OK) ? SQLITE_NOMEM : rv;
+  }
+
+  o->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (o->fd < 0) {
+    free(o);
+    sqlite3_finalize(s);
+    return SQLITE_CANTOPEN;
+  }
+  o->err = false;
+  o->bytes = 0;
+  o->len = 0;
+
+  cc = sqlite3_column_count(s);
+
+  if (format == SQLC_EXPORT_CSV) {
+    for (jj=0; jj<cc; ++jj) {
+      const char * name = sqlite3_column_name(s, jj);
+      if (jj > 0) sqlc_out_put(o, ",", 1);
+      sqlc_out_csv_field(o, name, strlen(name));
+    }
+    sqlc_out_put(o, "\r\n", 2);
+  }
+
+  while (!o->err && (rv = sqlite3_step(s)) == SQLITE_ROW) {
+    if (format == SQLC_EXPORT_NDJSON) sqlc_out_put(o, "{", 1);
+
+    for (jj=0; jj<cc; ++jj) {
+      int ct = sqlite3_column_type(s, jj);
+      const char * t = (const char *)sqlite3_column_text(s, jj);
+      size_t tl = sqlite3_column_bytes(s, jj);
+
+      if (jj > 0) sqlc_out_put(o, ",", 1);
+
+      if (format == SQLC_EXPORT_CSV) {
+        // (an empty field is read back as NULL by sqlc_db_import())
+        if (ct != SQLITE_NULL) {
+          if (tl == 0) sqlc_out_put(o, "\"\"", 2);
+          else sqlc_out_csv_field(o, t, tl);
+        }
+      } else {
+        const char * name = sqlite3_column_name(s, jj);
+        sqlc_out_json_string(o, name, strlen(name));
+        sqlc_out_put(o, ":", 1);
+        if (ct == SQLITE_NULL) sqlc_out_put(o, "null", 4);
+        else if (ct == SQLITE_INTEGER || ct == SQLITE_FLOAT) sqlc_out_put(o, t, tl);
+        else sqlc_out_json_string(o, t, tl);
+      }
+    }
+
+    sqlc_out_put(o, (format == SQLC_EXPORT_CSV) ? "\r\n" : "}\n", 2);
+    ++v[SQLC_EXPORT_STAT_ROWS];
+  }
+
+  sqlc_out_flush(o);
+  if (close(o->fd) != 0) o->err = true;
+
+  if (rv == SQLITE_DONE) rv = SQLITE_OK;
+  if (o->err && (rv == SQLITE_OK || rv == SQLITE_ROW)) rv = SQLITE_IOERR;
+  v[SQLC_EXPORT_STAT_BYTES] = o->bytes;
+
+  free(o);
+  sqlite3_finalize(s);
+
+  if (stats != NULL && n > 0) memcpy(stats, v, n * sizeof(sqlc_long_t));
+  return rv;
+}
+
+struct sqlc_in {
+  int fd;
+  bool eof;
+  sqlc_long_t bytes;
+  char * buf;
+  size_t alloc;
+  size_t start; // start of the next record
+  size_t end; // end of the data read so far
+};
+
+// Read more data after the current record, growing the buffer if a record does not fit
+static int sqlc_in_fill(struct sqlc_in * in)
+{
+  ssize_t r;
+
+  if (in->start > 0) {
+    memmove(in->buf, in->buf+in->start, in->end - in->start);
+    in->end -= in->start;
+    in->start = 0;
+  }
+
+  if (in->end == in->alloc) {
+    // NOTE: uses malloc/memcpy/free instead of realloc (see sqlc_fj_run)
+    char * old = in->buf;
+    in->alloc += in->alloc;
+    in->buf = malloc(in->alloc);
+    if (in->buf != NULL) memcpy(in->buf, old, in->end);
+    free(old);
+    if (in->buf == NULL) return SQLITE_NOMEM;
+  }
+
+  do {
+    r = read(in->fd, in->buf+in->end, in->alloc - in->end);
+  } while (r < 0 && errno == EINTR);
+
+  if (r < 0) return SQLITE_IOERR;
+  if (r == 0) in->eof = true;
+  in->end += r;
+  in->bytes += r;
+  return SQLITE_OK;
+}
+
+// Get the next record (line, or CSV record with quoted line breaks) without the line end,
+// returns SQLITE_ROW, SQLITE_DONE at the end of the file or an error code
+static int sqlc_in_record(struct sqlc_in * in, int format, char ** rec, size_t * rl)
+{
+  for (;;) {
+    size_t i = in->start;
+    bool inq = false;
+
+    if (format == SQLC_EXPORT_CSV) {
+      for (; i<in->end; ++i) {
+        if (in->buf[i] == '\"') inq = !inq;
+        else if (in->buf[i] == '\n' && !inq) break;
+      }
+    } else {
+      char * nl = memchr(in->buf+in->start, '\n', in->end - in->start);
+      if (nl != NULL) i = nl - in->buf;
+      else i = in->end;
+    }
+
+    if (i < in->end || (in->eof && in->start < in->end)) {
+      *rec = in->buf + in->start;
+      *rl = i - in->start;
+      if (*rl > 0 && (*rec)[*rl - 1] == '\r') --*rl;
+      in->start = (i < in->end) ? i+1 : i;
+      return SQLITE_ROW;
+    }
+
+    if (in->eof) return SQLITE_DONE;
+
+    {
+      int rv = sqlc_in_fill(in);
+      if (rv != SQLITE_OK) return rv;
+    }
+  }
+}
+
+// Bind the fields of a CSV record in order (unquoted in place), an empty unquoted field is NULL
+static int sqlc_bind_csv_record(sqlite3_stmt * s, char * rec, size_t rl)
+{
+  int pc = sqlite3_bind_parameter_count(s);
+  size_t i = 0;
+  int bi = 0;
+  int rv = SQLITE_OK;
+
+  for (;;) {
+    size_t j, k;
+    char * f = rec + i;
+    size_t fl;
+    bool isnull = false;
+
+    if (i < rl && rec[i] == '\"') {
+      f = rec + i + 1;
+      k = 0;
+      for (j=i+1; j<rl; ++j) {
+        if (rec[j] == '\"') {
+          if (j+1 < rl && rec[j+1] == '\"') ++j;
+          else break;
+        }
+        f[k++] = rec[j];
+      }
+      fl = k;
+      // (ignore anything between the closing quote & the next comma)
+      while (j<rl && rec[j] != ',') ++j;
+    } else {
+      for (j=i; j<rl && rec[j] != ','; ++j) ;
+      fl = j - i;
+      isnull = (fl == 0);
+    }
+
+    if (++bi <= pc && rv == SQLITE_OK)
+      rv = isnull ? sqlite3_bind_null(s, bi) : sqlite3_bind_text64(s, bi, f, fl, SQLITE_STATIC, SQLITE_UTF8);
+
+    if (j >= rl) break;
+    i = j+1;
+  }
+
+  return rv;
+}
+
+// Number of tokens in a JSON value, including the nested tokens
+static int sqlc_json_skip(const jsmntok_t * tokn)
+{
+  int n = 1;
+  int i;
+
+  for (i=0; i<tokn->size; ++i) n += sqlc_json_skip(tokn+n);
+  return n;
+}
+
+// Bind a JSON array (in order) or object (by parameter name :key, @key or $key,
+// in order if the statement has positional parameters)
+static int sqlc_bind_json_record(sqlite3_stmt * s, const char * json, const jsmntok_t * tokn)
+{
+  bool named = (sqlite3_bind_parameter_count(s) > 0 && sqlite3_bind_parameter_name(s, 1) != NULL);
+  int pc = sqlite3_bind_parameter_count(s);
+  const jsmntok_t * t = tokn+1;
+  int i;
+  int rv = SQLITE_OK;
+
+  if (tokn->type != JSMN_ARRAY && tokn->type != JSMN_OBJECT) return SQLITE_MISMATCH;
+
+  for (i=0; i<tokn->size && rv == SQLITE_OK; ++i) {
+    int bi = i+1;
+
+    if (tokn->type == JSMN_OBJECT) {
+      if (named) {
+        static const char prefix[] = ":@$";
+        char name[128];
+        size_t kl = t->end - t->start;
+        int pi;
+
+        bi = 0;
+        if (kl + 2 <= sizeof(name)) {
+          for (pi=0; pi<3 && bi == 0; ++pi) {
+            name[0] = prefix[pi];
+            memcpy(name+1, json+t->start, kl);
+            name[kl+1] = '\0';
+            bi = sqlite3_bind_parameter_index(s, name);
+          }
+        }
+      }
+      ++t; // key -> value
+    }
+
+    if (bi > 0 && bi <= pc) rv = sqlc_bind_json_value(s, bi, json, t);
+    t += sqlc_json_skip(t);
+  }
+
+  return rv;
+}
+
+int sqlc_db_import(sqlc_handle_t db, const char *path, int format, const char *sql, int chunk_rows, void *stats, int len)
+{
+  sqlite3 *mydb = HANDLE_TO_VP(db);
+  sqlite3_stmt *s = NULL;
+  struct sqlc_in in;
+  jsmntok_t *tokn = NULL;
+  unsigned int tokn_alloc = 0;
+  sqlc_long_t *v = stats;
+  int n = len / sizeof(sqlc_long_t);
+  sqlc_long_t v0[SQLC_IMPORT_STAT_COUNT] = { 0, 0, 0, 0 };
+  bool own_tx = false;
+  bool intx = false;
+  int chunk = 0;
+  int rv;
+  char *rec;
+  size_t rl;
+
+  MYLOG("%s %p %s %d %d", __func__, mydb, path, format, chunk_rows);
+
+  if (format != SQLC_EXPORT_NDJSON && format != SQLC_EXPORT_CSV) return SQLITE_MISUSE;
+  if (chunk_rows <= 0) chunk_rows = SQLC_IMPORT_DEFAULT_CHUNK;
+  // (use the stats buffer only if it has room for all counts)
+  if (v == NULL || n < SQLC_IMPORT_STAT_COUNT) {
+    v = v0;
+    n = SQLC_IMPORT_STAT_COUNT;
+  }
+  memset(v, 0, SQLC_IMPORT_STAT_COUNT * sizeof(sqlc_long_t));
+
+  rv = sqlite3_prepare_v2(mydb, sql, -1, &s, NULL);
+  if (rv != SQLITE_OK) return rv;
+
+  in.fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (in.fd < 0) {
+    sqlite3_finalize(s);
+    return SQLITE_CANTOPEN;
+  }
+  in.eof = false;
+  in.bytes = 0;
+  in.alloc = SQLC_IO_BUF_SIZE;
+  in.start = in.end = 0;
+  in.buf = malloc(in.alloc);
+  if (in.buf == NULL) {
+    close(in.fd);
+    sqlite3_finalize(s);
+    return SQLITE_NOMEM;
+  }
+
+  // chunked transactions only if the caller has not started one:
+  own_tx = sqlite3_get_autocommit(mydb);
+
+  // CSV header line:
+  if (format == SQLC_EXPORT_CSV) rv = sqlc_in_record(&in, format, &rec, &rl);
+
+  while (rv == SQLITE_OK || rv == SQLITE_ROW) {
+    int rrv;
+
+    rv = sqlc_in_record(&in, format, &rec, &rl);
+    if (rv != SQLITE_ROW) break;
+
+    if (format == SQLC_EXPORT_NDJSON) {
+      size_t i;
+      for (i=0; i<rl && (rec[i] == ' ' || rec[i] == '\t'); ++i) ;
+      if (i == rl) continue;
+    } else if (rl == 0) {
+      continue;
+    }
+
+    if (own_tx && !intx) {
+      rv = sqlite3_exec(mydb, "BEGIN", NULL, NULL, NULL);
+      if (rv != SQLITE_OK) break;
+      intx = true;
+    }
+
+    ++v[SQLC_IMPORT_STAT_ROWS];
+
+    if (format == SQLC_EXPORT_CSV) {
+      rrv = sqlc_bind_csv_record(s, rec, rl);
+    } else {
+      jsmn_parser myparser;
+      int r = 0;
+
+      do {
+        if (tokn_alloc == 0 || r == JSMN_ERROR_NOMEM) {
+          free(tokn);
+          tokn_alloc = (tokn_alloc == 0) ? 64 : tokn_alloc * 2;
+          tokn = malloc(tokn_alloc * sizeof(jsmntok_t));
+          if (tokn == NULL) break;
+        }
+        jsmn_init(&myparser);
+        r = jsmn_parse(&myparser, rec, rl, tokn, tokn_alloc);
+      } while (r == JSMN_ERROR_NOMEM);
+
+      if (tokn == NULL) {
+        rv = SQLITE_NOMEM;
+        break;
+      }
+      rrv = (r < 1) ? SQLITE_MISMATCH : sqlc_bind_json_record(s, rec, tokn);
+    }
+
+    if (rrv == SQLITE_OK) {
+      rrv = sqlite3_step(s);
+      if (rrv == SQLITE_DONE || rrv == SQLITE_ROW) rrv = SQLITE_OK;
+    }
+    sqlite3_reset(s);
+    sqlite3_clear_bindings(s);
+
+    // (primary result code, also with SQLITE_OPEN_EXRESCODE)
+    if ((rrv & 0xff) == SQLITE_NOMEM) {
+      rv = rrv;
+      break;
+    }
+
+    if (rrv == SQLITE_OK) {
+      ++v[SQLC_IMPORT_STAT_INSERTED];
+    } else if ((rrv & 0xff) == SQLITE_CONSTRAINT || (rrv & 0xff) == SQLITE_MISMATCH ||
+               (rrv & 0xff) == SQLITE_TOOBIG || (rrv & 0xff) == SQLITE_RANGE) {
+      sqlc_long_t ei = SQLC_IMPORT_STAT_COUNT + v[SQLC_IMPORT_STAT_ERRORS];
+      if (ei < n) v[ei] = v[SQLC_IMPORT_STAT_ROWS];
+      ++v[SQLC_IMPORT_STAT_ERRORS];
+    } else {
+      // the whole chunk is rolled back for any other error:
+      rv = rrv;
+      break;
+    }
+
+    if (intx && ++chunk >= chunk_rows) {
+      rv = sqlite3_exec(mydb, "COMMIT", NULL, NULL, NULL);
+      if (rv != SQLITE_OK) break;
+      intx = false;
+      chunk = 0;
+    }
+  }
+
+  if (rv == SQLITE_DONE) rv = SQLITE_OK;
+
+  if (intx) {
+    if (rv == SQLITE_OK) {
+      rv = sqlite3_exec(mydb, "COMMIT", NULL, NULL, NULL);
+    }
+    if (rv != SQLITE_OK && !sqlite3_get_autocommit(mydb)) {
+      sqlite3_exec(mydb, "ROLLBACK", NULL, NULL, NULL);
+    }
+  }
+
+  v[SQLC_IMPORT_STAT_BYTES] = in.bytes;
+
+  free(tokn);
+  free(in.buf);
+  close(in.fd);
+  sqlite3_finalize(s);
+
+  return rv;
+}
+
+// Page cache warmup:
+
+static sqlc_long_t sqlc_cache_misses(sqlite3 * mydb)
+{
+  int cur = 0, hi = 0;
+  sqlite3_db_status(mydb, SQLITE_DBSTATUS_CACHE_MISS, &cur, &hi, 0);
+  return cur;
+}
+
+// Scan one table (NOT INDEXED) or index (INDEXED BY) so that its pages are read into the page cache,
+// stop once there have been max_pages cache misses since miss0 (if max_pages > 0).
+// Partial indexes are skipped (INDEXED BY without the WHERE of the index has no query plan).
+static int sqlc_warmup_btree(sqlite3 * mydb, const char * name, sqlc_long_t miss0, sqlc_long_t max_pages)
+{
+  sqlite3_stmt * s = NULL;
+  char * sql = NULL;
+  int n = 0;
+  int rv;
+
+  rv = sqlite3_prepare_v2(mydb, "SELECT type, tbl_name, type='index' AND"
+    " (SELECT partial FROM pragma_index_list(tbl_name, 'main') WHERE name=?1) FROM main.sqlite_schema"
+    " WHERE name=?1 AND rootpage>0 AND type IN ('table','index')", -1, &s, NULL);
+  if (rv != SQLITE_OK) return rv;
+
+  sqlite3_bind_text(s, 1, name, -1, SQLITE_STATIC);
+  rv = sqlite3_step(s);
+  if (rv == SQLITE_ROW) {
+    const char * type = (const char *)sqlite3_column_text(s, 0);
+    const char * tbl = (const char *)sqlite3_column_text(s, 1);
+
+    if (sqlite3_column_int(s, 2)) {
+      sqlite3_finalize(s);
+      return SQLITE_OK;
+    }
+
+    if (type[0] == 'i')
+      sql = sqlite3_mprintf("SELECT 1 FROM main.\"%w\" INDEXED BY \"%w\"", tbl, name);
+    else
+      sql = sqlite3_mprintf("SELECT 1 FROM main.\"%w\" NOT INDEXED", name);
+    rv = (sql == NULL) ? SQLITE_NOMEM : SQLITE_OK;
+  } else if (rv == SQLITE_DONE) {
+    rv = SQLITE_NOTFOUND;
+  }
+  sqlite3_finalize(s);
+  if (rv != SQLITE_OK) return rv;
+
+  rv = sqlite3_prepare_v2(mydb, sql, -1, &s, NULL);
+  sqlite3_free(sql);
+  if (rv != SQLITE_OK) return rv;
+
+  while ((rv = sqlite3_step(s)) == SQLITE_ROW) {
+    if (max_pages > 0 && (++n & 255) == 0 && sqlc_cache_misses(mydb) - miss0 >= max_pages) {
+      rv = SQLITE_DONE;
+      break;
+    }
+  }
+  sqlite3_finalize(s);
+
+  return (rv == SQLITE_DONE) ? SQLITE_OK : rv;
+}
+
+int sqlc_db_warmup(sqlc_handle_t db, const char *names, sqlc_long_t max_bytes, void *stats, int len)
+{
+  sqlite3 *mydb = HANDLE_TO_VP(db);
+  sqlc_long_t v[SQLC_WARMUP_STAT_COUNT] = { 0, 0, 0 };
+  int n = len / sizeof(sqlc_long_t);
+  sqlc_long_t t0 = fj_now_ms();
+  sqlc_long_t miss0 = sqlc_cache_misses(mydb);
+  sqlc_long_t page_size = 0;
+  sqlc_long_t max_pages = 0;
+  sqlite3_stmt *s = NULL;
+  int rv;
+
+  MYLOG("%s %p %s %lld", __func__, mydb, names, max_bytes);
+
+  if (n > SQLC_WARMUP_STAT_COUNT) n = SQLC_WARMUP_STAT_COUNT;
+
+  rv = sqlite3_prepare_v2(mydb, "PRAGMA main.page_size", -1, &s, NULL);
+  if (rv == SQLITE_OK && sqlite3_step(s) == SQLITE_ROW) page_size = sqlite3_column_int64(s, 0);
+  sqlite3_finalize(s);
+  if (rv != SQLITE_OK) return rv;
+
+  if (max_bytes > 0 && page_size > 0) max_pages = (max_bytes + page_size - 1) / page_size;
+
+  if (names == NULL || names[0] == '\0') {
+#ifdef POSIX_FADV_WILLNEED
+    // the whole database: ask the OS to start reading the file ahead as well
+    const char * filename = sqlite3_db_filename(mydb, "main");
+    if (filename != NULL && filename[0] != '\0') {
+      int fd = open(filename, O_RDONLY | O_CLOEXEC);
+      if (fd >= 0) {
+        posix_fadvise(fd, 0, (max_bytes > 0) ? max_bytes : 0, POSIX_FADV_WILLNEED);
+        close(fd);
+      }
+    }
+#endif
+
+    rv = sqlite3_prepare_v2(mydb, "SELECT name FROM main.sqlite_schema"
+      " WHERE rootpage>0 AND type IN ('table','index') ORDER BY rootpage", -1, &s, NULL);
+    if (rv != SQLITE_OK) return rv;
+
+    while (rv == SQLITE_OK && (max_pages == 0 || sqlc_cache_misses(mydb) - miss0 < max_pages)) {
+      rv = sqlite3_step(s);
+      if (rv != SQLITE_ROW) break;
+      rv = sqlc_warmup_btree(mydb, (const char *)sqlite3_column_text(s, 0), miss0, max_pages);
+    }
+    sqlite3_finalize(s);
+    if (rv == SQLITE_DONE) rv = SQLITE_OK;
+  } else {
+    // comma-separated list of table & index names:
+    char * list = sqlite3_mprintf("%s", names);
+    char * name;
+    char * next;
+    bool notfound = false;
+
+    if (list == NULL) return SQLITE_NOMEM;
+
+    for (name = list; name != NULL && rv == SQLITE_OK; name = next) {
+      size_t nl;
+
+      next = strchr(name, ',');
+      if (next != NULL) *next++ = '\0';
+      while (*name == ' ') ++name;
+      for (nl = strlen(name); nl > 0 && name[nl-1] == ' '; --nl) name[nl-1] = '\0';
+      if (name[0] == '\0') continue;
+
+      if (max_pages > 0 && sqlc_cache_misses(mydb) - miss0 >= max_pages) break;
+      rv = sqlc_warmup_btree(mydb, name, miss0, max_pages);
+      if (rv == SQLITE_NOTFOUND) {
+        notfound = true;
+        rv = SQLITE_OK;
+      }
+    }
+    sqlite3_free(list);
+    if (rv == SQLITE_OK && notfound) rv = SQLITE_NOTFOUND;
+  }
+
+  v[SQLC_WARMUP_STAT_PAGES] = sqlc_cache_misses(mydb) - miss0;
+  v[SQLC_WARMUP_STAT_BYTES] = v[SQLC_WARMUP_STAT_PAGES] * page_size;
+  v[SQLC_WARMUP_STAT_MS] = fj_now_ms() - t0;
+
+  if (stats != NULL && n > 0) memcpy(stats, v, n * sizeof(sqlc_long_t));
+  return rv;
+}
+
+// In-memory database load/save:
+
+int sqlc_db_deserialize(sqlc_handle_t db, const char *schema, void *buf, sqlc_long_t size, int flags)
+{
+  sqlite3 *mydb = HANDLE_TO_VP(db);
+  unsigned char *data = buf;
+  unsigned int dflags = SQLITE_DESERIALIZE_READONLY;
+
+  MYLOG("%s %p %s %lld %d", __func__, mydb, schema, size, flags);
+
+  if (buf == NULL || size < 0) return SQLITE_MISUSE;
+
+  if (!(flags & SQLC_DESERIALIZE_READONLY)) {
+    // (copy) the database is writable & the copy is freed by SQLite:
+    data = sqlite3_malloc64(size > 0 ? size : 1);
+    if (data == NULL) return SQLITE_NOMEM;
+    memcpy(data, buf, size);
+    dflags = SQLITE_DESERIALIZE_FREEONCLOSE | SQLITE_DESERIALIZE_RESIZEABLE;
+  }
+
+  // NOTE: frees the copy in case of an error
+  return sqlite3_deserialize(mydb, schema, data, size, size, dflags);
+}
+
+int sqlc_db_deserialize_file(sqlc_handle_t db, const char *schema, const char *path, sqlc_long_t offset, sqlc_long_t size, int flags)
+{
+  sqlite3 *mydb = HANDLE_TO_VP(db);
+  unsigned char *data;
+  sqlc_long_t done = 0;
+  unsigned int dflags = SQLITE_DESERIALIZE_FREEONCLOSE;
+  int fd;
+
+  MYLOG("%s %p %s %s %lld %lld", __func__, mydb, schema, path, offset, size);
+
+  if (offset < 0 || size < 0) return SQLITE_MISUSE;
+
+  fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) return SQLITE_CANTOPEN;
+
+  if (size == 0) {
+    off_t end = lseek(fd, 0, SEEK_END);
+    if (end < offset) {
+      close(fd);
+      return SQLITE_IOERR;
+    }
+    size = end - offset;
+  }
+
+  data = sqlite3_malloc64(size > 0 ? size : 1);
+  if (data == NULL) {
+    close(fd);
+    return SQLITE_NOMEM;
+  }
+
+  while (done < size) {
+    ssize_t r = pread(fd, data+done, size-done, offset+done);
+    if (r < 0 && errno == EINTR) continue;
+    if (r <= 0) break;
+    done += r;
+  }
+  close(fd);
+
+  if (done < size) {
+    sqlite3_free(data);
+    return SQLITE_IOERR;
+  }
+
+  if (flags & SQLC_DESERIALIZE_READONLY) dflags |= SQLITE_DESERIALIZE_READONLY;
+  else dflags |= SQLITE_DESERIALIZE_RESIZEABLE;
+
+  return sqlite3_deserialize(mydb, schema, data, size, size, dflags);
+}
+
+sqlc_long_t sqlc_db_serialize(sqlc_handle_t db, const char *schema, void *buf, sqlc_long_t len)
+{
+  sqlite3 *mydb = HANDLE_TO_VP(db);
+  sqlite3_int64 size = -1;
+  unsigned char *data;
+
+  MYLOG("%s %p %s %lld", __func__, mydb, schema, len);
+
+  // no copy if the database is already in one block of memory (such as after sqlc_db_deserialize()):
+  data = sqlite3_serialize(mydb, schema, &size, SQLITE_SERIALIZE_NOCOPY);
+  if (size < 0) return -SQLITE_ERROR;
+  if (buf == NULL || len < size) return size;
+
+  if (data != NULL) {
+    memcpy(buf, data, size);
+  } else {
+    data = sqlite3_serialize(mydb, schema, &size, 0);
+    if (data == NULL) return -SQLITE_NOMEM;
+    if (size > len) {
+      // (changed by another connection in the meantime)
+      sqlite3_free(data);
+      return size;
+    }
+    memcpy(buf, data, size);
+    sqlite3_free(data);
+  }
+
+  return size;
+}
+
+// Read-only VFS over a range of a file (mapped), other files are opened by the default VFS:
+
+struct sqlc_range_file {
+  sqlite3_file base;
+  void * map;
+  size_t map_len;
+  const unsigned char * data; // start of the database in the mapping
+  sqlite3_int64 size;
+};
+
+static int sqlc_range_close(sqlite3_file * f)
+{
+  struct sqlc_range_file * rf = (struct sqlc_range_file *)f;
+  if (rf->map != NULL) munmap(rf->map, rf->map_len);
+  rf->map = NULL;
+  return SQLITE_OK;
+}
+
+static int sqlc_range_read(sqlite3_file * f, void * buf, int amt, sqlite3_int64 off)
+{
+  struct sqlc_range_file * rf = (struct sqlc_range_file *)f;
+  sqlite3_int64 n = (off >= rf->size) ? 0 : rf->size - off;
+
+  if (n >= amt) {
+    memcpy(buf, rf->data + off, amt);
+    return SQLITE_OK;
+  }
+
+  if (n > 0) memcpy(buf, rf->data + off, n);
+  memset((char *)buf + n, 0, amt - n);
+  return SQLITE_IOERR_SHORT_READ;
+}
+
+static int sqlc_range_write(sqlite3_file * f, const void * buf, int amt, sqlite3_int64 off)
+{
+  return SQLITE_READONLY;
+}
+
+static int sqlc_range_truncate(sqlite3_file * f, sqlite3_int64 size)
+{
+  return SQLITE_READONLY;
+}
+
+static int sqlc_range_sync(sqlite3_file * f, int flags)
+{
+  return SQLITE_OK;
+}
+
+static int sqlc_range_file_size(sqlite3_file * f, sqlite3_int64 * size)
+{
+  *size = ((struct sqlc_range_file *)f)->size;
+  return SQLITE_OK;
+}
+
+static int sqlc_range_lock(sqlite3_file * f, int lock)
+{
+  return SQLITE_OK;
+}
+
+static int sqlc_range_check_reserved_lock(sqlite3_file * f, int * res)
+{
+  *res = 0;
+  return SQLITE_OK;
+}
+
+static int sqlc_range_file_control(sqlite3_file * f, int op, void * arg)
+{
+  return SQLITE_NOTFOUND;
+}
+
+static int sqlc_range_sector_size(sqlite3_file * f)
+{
+  return 4096;
+}
+
+static int sqlc_range_device_characteristics(sqlite3_file * f)
+{
+  return SQLITE_IOCAP_IMMUTABLE;
+}
+
+// pages are used in place from the mapping if memory-mapped I/O is enabled (PRAGMA mmap_size)
+static int sqlc_range_fetch(sqlite3_file * f, sqlite3_int64 off, int amt, void ** pp)
+{
+  struct sqlc_range_file * rf = (struct sqlc_range_file *)f;
+  *pp = (off + amt <= rf->size) ? (void *)(rf->data + off) : NULL;
+  return SQLITE_OK;
+}
+
+static int sqlc_range_unfetch(sqlite3_file * f, sqlite3_int64 off, void * p)
+{
+  return SQLITE_OK;
+}
+
+static const sqlite3_io_methods sqlc_range_io_methods = {
+  3,
+  sqlc_range_close,
+  sqlc_range_read,
+  sqlc_range_write,
+  sqlc_range_truncate,
+  sqlc_range_sync,
+  sqlc_range_file_size,
+  sqlc_range_lock,
+  sqlc_range_lock,
+  sqlc_range_check_reserved_lock,
+  sqlc_range_file_control,
+  sqlc_range_sector_size,
+  sqlc_range_device_characteristics,
+  NULL, // no shared memory (WAL not supported)
+  NULL,
+  NULL,
+  NULL,
+  sqlc_range_fetch,
+  sqlc_range_unfetch
+};
+
+static int sqlc_range_open(sqlite3_vfs * vfs, const char * name, sqlite3_file * f, int flags, int * out_flags)
+{
+  sqlite3_vfs * base = vfs->pAppData;
+  struct sqlc_range_file * rf = (struct sqlc_range_file *)f;
+  sqlite3_int64 offset, length;
+  sqlite3_int64 page_size = sysconf(_SC_PAGESIZE);
+  sqlite3_int64 map_offset;
+  struct stat st;
+  int fd;
+
+  if (!(flags & SQLITE_OPEN_MAIN_DB)) return base->xOpen(base, name, f, flags, out_flags);
+
+  rf->base.pMethods = NULL;
+  rf->map = NULL;
+
+  if (name == NULL) return SQLITE_CANTOPEN;
+
+  offset = sqlite3_uri_int64(name, "offset", 0);
+  length = sqlite3_uri_int64(name, "length", 0);
+  if (offset < 0 || length < 0) return SQLITE_CANTOPEN;
+
+  fd = open(name, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) return SQLITE_CANTOPEN;
+
+  if (fstat(fd, &st) != 0 || offset > st.st_size || length > st.st_size - offset) {
+    close(fd);
+    return SQLITE_CANTOPEN;
+  }
+  if (length == 0) length = st.st_size - offset;
+
+  rf->size = length;
+  map_offset = offset - offset % page_size;
+  rf->map_len = (offset - map_offset) + length;
+
+  if (rf->map_len > 0) {
+    rf->map = mmap(NULL, rf->map_len, PROT_READ, MAP_SHARED, fd, map_offset);
+    if (rf->map == MAP_FAILED) rf->map = NULL;
+  }
+  close(fd);
+
+  if (rf->map_len > 0 && rf->map == NULL) return SQLITE_CANTOPEN;
+
+  rf->data = (const unsigned char *)rf->map + (offset - map_offset);
+  rf->base.pMethods = &sqlc_range_io_methods;
+  if (out_flags != NULL) *out_flags = SQLITE_OPEN_READONLY | SQLITE_OPEN_MAIN_DB;
+  return SQLITE_OK;
+}
+
+static int sqlc_range_delete(sqlite3_vfs * vfs, const char * name, int sync_dir)
+{
+  sqlite3_vfs * base = vfs->pAppData;
+  return base->xDelete(base, name, sync_dir);
+}
+
+static int sqlc_range_access(sqlite3_vfs * vfs, const char * name, int flags, int * res)
+{
+  sqlite3_vfs * base = vfs->pAppData;
+  return base->xAccess(base, name, flags, res);
+}
+
+static int sqlc_range_full_pathname(sqlite3_vfs * vfs, const char * name, int n, char * out)
+{
+  sqlite3_vfs * base = vfs->pAppData;
+  return base->xFullPathname(base, name, n, out);
+}
+
+static void * sqlc_range_dl_open(sqlite3_vfs * vfs, const char * name)
+{
+  sqlite3_vfs * base = vfs->pAppData;
+  return base->xDlOpen(base, name);
+}
+
+static void sqlc_range_dl_error(sqlite3_vfs * vfs, int n, char * msg)
+{
+  sqlite3_vfs * base = vfs->pAppData;
+  base->xDlError(base, n, msg);
+}
+
+static void (*sqlc_range_dl_sym(sqlite3_vfs * vfs, void * h, const char * sym))(void)
+{
+  sqlite3_vfs * base = vfs->pAppData;
+  return base->xDlSym(base, h, sym);
+}
+
+static void sqlc_range_dl_close(sqlite3_vfs * vfs, void * h)
+{
+  sqlite3_vfs * base = vfs->pAppData;
+  base->xDlClose(base, h);
+}
+
+static int sqlc_range_randomness(sqlite3_vfs * vfs, int n, char * out)
+{
+  sqlite3_vfs * base = vfs->pAppData;
+  return base->xRandomness(base, n, out);
+}
+
+static int sqlc_range_sleep(sqlite3_vfs * vfs, int us)
+{
+  sqlite3_vfs * base = vfs->pAppData;
+  return base->xSleep(base, us);
+}
+
+static int sqlc_range_current_time(sqlite3_vfs * vfs, double * t)
+{
+  sqlite3_vfs * base = vfs->pAppData;
+  return base->xCurrentTime(base, t);
+}
+
+static int sqlc_range_get_last_error(sqlite3_vfs * vfs, int n, char * msg)
+{
+  sqlite3_vfs * base = vfs->pAppData;
+  return (base->xGetLastError != NULL) ? base->xGetLastError(base, n, msg) : 0;
+}
+
+static int sqlc_range_current_time_int64(sqlite3_vfs * vfs, sqlite3_int64 * t)
+{
+  sqlite3_vfs * base = vfs->pAppData;
+  return base->xCurrentTimeInt64(base, t);
+}
+
+static sqlite3_vfs sqlc_range_vfs = {
+  2,
+  0, // szOsFile (set when registered)
+  0, // mxPathname (set when registered)
+  NULL,
+  SQLC_RANGE_VFS,
+  NULL, // pAppData: the default VFS (set when registered)
+  sqlc_range_open,
+  sqlc_range_delete,
+  sqlc_range_access,
+  sqlc_range_full_pathname,
+  sqlc_range_dl_open,
+  sqlc_range_dl_error,
+  sqlc_range_dl_sym,
+  sqlc_range_dl_close,
+  sqlc_range_randomness,
+  sqlc_range_sleep,
+  sqlc_range_current_time,
+  sqlc_range_get_last_error,
+  sqlc_range_current_time_int64
+};
+
+int sqlc_range_vfs_register(void)
+{
+  sqlite3_vfs * base;
+  int rv;
+
+  MYLOG("%s", __func__);
+
+  rv = sqlite3_initialize();
+  if (rv != SQLITE_OK) return rv;
+
+  // (already registered)
+  if (sqlite3_vfs_find(SQLC_RANGE_VFS) != NULL) return SQLITE_OK;
+
+  base = sqlite3_vfs_find(NULL);
+  if (base == NULL || base->iVersion < 2) return SQLITE_ERROR;
+
+  sqlc_range_vfs.szOsFile = (base->szOsFile > (int)sizeof(struct sqlc_range_file)) ?
+    base->szOsFile : (int)sizeof(struct sqlc_range_file);
+  sqlc_range_vfs.mxPathname = base->mxPathname;
+  sqlc_range_vfs.pAppData = base;
+
+  return sqlite3_vfs_register(&sqlc_range_vfs, 0);
+}
+
+// Native SQL functions:
+
+static void sqlc_fn_regfree(void * p)
+{
+  regfree(p);
+  sqlite3_free(p);
+}
+
+// regexp(pattern, text) for text REGEXP pattern (POSIX extended, compiled pattern cached per statement)
+static void sqlc_fn_regexp(sqlite3_context * ctx, int argc, sqlite3_value ** argv)
+{
+  regex_t * re = sqlite3_get_auxdata(ctx, 0);
+  const char * text;
+
+  if (sqlite3_value_type(argv[0]) == SQLITE_NULL || sqlite3_value_type(argv[1]) == SQLITE_NULL) return;
+
+  if (re == NULL) {
+    const char * pattern = (const char *)sqlite3_value_text(argv[0]);
+    int rv;
+
+    re = sqlite3_malloc(sizeof(regex_t));
+    if (re == NULL || pattern == NULL) {
+      sqlite3_free(re);
+      sqlite3_result_error_nomem(ctx);
+      return;
+    }
+
+    rv = regcomp(re, pattern, REG_EXTENDED | REG_NOSUB);
+    if (rv != 0) {
+      char msg[200];
+      regerror(rv, re, msg, sizeof(msg));
+      sqlite3_free(re);
+      sqlite3_result_error(ctx, msg, -1);
+      return;
+    }
+
+    sqlite3_set_auxdata(ctx, 0, re, sqlc_fn_regfree);
+    re = sqlite3_get_auxdata(ctx, 0);
+    if (re == NULL) {
+      sqlite3_result_error_nomem(ctx);
+      return;
+    }
+  }
+
+  text = (const char *)sqlite3_value_text(argv[1]);
+  if (text == NULL) {
+    sqlite3_result_error_nomem(ctx);
+    return;
+  }
+
+  sqlite3_result_int(ctx, regexec(re, text, 0, NULL, 0) == 0);
+}
+
+static sqlite3_uint64 sqlc_fnv1a64(const unsigned char * p, int n)
+{
+  sqlite3_uint64 h = 14695981039346656037ULL;
+  int i;
+
+  for (i=0; i<n; ++i) {
+    h ^= p[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+// 64-bit FNV-1a of a value (text as UTF-8, numbers as text), with the type so that 1 != '1'
+static sqlite3_uint64 sqlc_value_hash(sqlite3_value * v)
+{
+  int t = sqlite3_value_type(v);
+  const unsigned char * p;
+  int n;
+
+  if (t == SQLITE_NULL) return 0;
+
+  p = (t == SQLITE_BLOB) ? sqlite3_value_blob(v) : sqlite3_value_text(v);
+  n = sqlite3_value_bytes(v);
+  return sqlc_fnv1a64(p, n) ^ (sqlite3_uint64)t;
+}
+
+// fnv1a64(x): 64-bit FNV-1a hash of the text or blob bytes (NULL for NULL)
+static void sqlc_fn_fnv1a64(sqlite3_context * ctx, int argc, sqlite3_value ** argv)
+{
+  int t = sqlite3_value_type(argv[0]);
+  const unsigned char * p;
+
+  if (t == SQLITE_NULL) return;
+
+  p = (t == SQLITE_BLOB) ? sqlite3_value_blob(argv[0]) : sqlite3_value_text(argv[0]);
+  sqlite3_result_int64(ctx, (sqlite3_int64)sqlc_fnv1a64(p, sqlite3_value_bytes(argv[0])));
+}
+
+// fingerprint(x, ...): order-independent aggregate hash of the rows (such as to compare tables)
+static void sqlc_fn_fingerprint_step(sqlite3_context * ctx, int argc, sqlite3_value ** argv)
+{
+  sqlite3_uint64 * acc = sqlite3_aggregate_context(ctx, sizeof(sqlite3_uint64));
+  sqlite3_uint64 h = 0;
+  int i;
+
+  if (acc == NULL) return;
+
+  for (i=0; i<argc; ++i) h = (h ^ sqlc_value_hash(argv[i])) * 1099511628211ULL;
+
+  // mix the row hash (splitmix64 finalizer) before the sum:
+  h ^= h >> 30;
+  h *= 0xbf58476d1ce4e5b9ULL;
+  h ^= h >> 27;
+  h *= 0x94d049bb133111ebULL;
+  h ^= h >> 31;
+  *acc += h;
+}
+
+static void sqlc_fn_fingerprint_final(sqlite3_context * ctx)
+{
+  sqlite3_uint64 * acc = sqlite3_aggregate_context(ctx, 0);
+  sqlite3_result_int64(ctx, (acc == NULL) ? 0 : (sqlite3_int64)*acc);
+}
+
+// haversine(lat1, lon1, lat2, lon2): great-circle distance in meters (degrees in)
+static void sqlc_fn_haversine(sqlite3_context * ctx, int argc, sqlite3_value ** argv)
+{
+  const double r = 6371008.8; // mean earth radius in meters
+  const double d2r = 3.14159265358979323846 / 180;
+  double lat1, lat2, dlat, dlon, a;
+  int i;
+
+  for (i=0; i<4; ++i) if (sqlite3_value_type(argv[i]) == SQLITE_NULL) return;
+
+  lat1 = sqlite3_value_double(argv[0]) * d2r;
+  lat2 = sqlite3_value_double(argv[2]) * d2r;
+  dlat = lat2 - lat1;
+  dlon = (sqlite3_value_double(argv[3]) - sqlite3_value_double(argv[1])) * d2r;
+
+  a = sin(dlat/2) * sin(dlat/2) + cos(lat1) * cos(lat2) * sin(dlon/2) * sin(dlon/2);
+  if (a > 1) a = 1;
+  sqlite3_result_double(ctx, 2 * r * asin(sqrt(a)));
+}
+
+int sqlc_db_register_functions(sqlc_handle_t db, int mask)
+{
+  sqlite3 *mydb = HANDLE_TO_VP(db);
+  const int flags = SQLITE_UTF8 | SQLITE_DETERMINISTIC | SQLITE_INNOCUOUS;
+  int rv = SQLITE_OK;
+
+  MYLOG("%s %p %d", __func__, mydb, mask);
+
+  if (rv == SQLITE_OK && (mask & SQLC_FUNC_REGEXP))
+    rv = sqlite3_create_function_v2(mydb, "regexp", 2, flags, NULL, sqlc_fn_regexp, NULL, NULL, NULL);
+
+  if (rv == SQLITE_OK && (mask & SQLC_FUNC_HASH))
+    rv = sqlite3_create_function_v2(mydb, "fnv1a64", 1, flags, NULL, sqlc_fn_fnv1a64, NULL, NULL, NULL);
+  if (rv == SQLITE_OK && (mask & SQLC_FUNC_HASH))
+    rv = sqlite3_create_function_v2(mydb, "fingerprint", -1, flags, NULL, NULL,
+      sqlc_fn_fingerprint_step, sqlc_fn_fingerprint_final, NULL);
+
+  if (rv == SQLITE_OK && (mask & SQLC_FUNC_GEO))
+    rv = sqlite3_create_function_v2(mydb, "haversine", 4, flags, NULL, sqlc_fn_haversine, NULL, NULL, NULL);
+
+  return rv;
+}
+
+// Batches on several databases in parallel:
+
+struct multi_item {
+  sqlc_handle_t fj;
+  char * batch_json;
+  int ll;
+  const char * result;
+  int next; // next item on the same database (-1 if none)
+};
+
+struct multi_s {
+  int max_threads;
+  struct multi_item * items;
+  int count;
+  int alloc;
+  int * tasks; // first item for each database
+  int task_count;
+  int next_task;
+  char * result;
+};
+
+sqlc_handle_t sqlc_multi_new(int max_threads)
+{
+  struct multi_s * mymulti;
+
+  MYLOG("%s %d", __func__, max_threads);
+
+  if (max_threads < 1) return -SQLITE_MISUSE;
+
+  mymulti = malloc(sizeof(struct multi_s));
+  if (mymulti == NULL) return -SQLITE_NOMEM;
+
+  mymulti->max_threads = max_threads;
+  mymulti->items = NULL;
+  mymulti->count = 0;
+  mymulti->alloc = 0;
+  mymulti->tasks = NULL;
+  mymulti->task_count = 0;
+  mymulti->next_task = 0;
+  mymulti->result = NULL;
+  return HANDLE_FROM_VP(mymulti);
+}
+
+int sqlc_multi_add(sqlc_handle_t multi, sqlc_handle_t fj, const char *batch_json, int ll)
+{
+  struct multi_s * mymulti = HANDLE_TO_VP(multi);
+  struct fj_s * myfj = HANDLE_TO_VP(fj);
+  struct multi_item * it;
+  int i;
+
+  MYLOG("%s %p %p", __func__, mymulti, myfj);
+
+  if (batch_json == NULL) return -SQLITE_MISUSE;
+
+  // (the result of each fj handle is only valid until its next run)
+  for (i=0; i<mymulti->count; ++i)
+    if (mymulti->items[i].fj == fj) return -SQLITE_MISUSE;
+
+  if (mymulti->count == mymulti->alloc) {
+    // NOTE: uses malloc/memcpy/free instead of realloc (see sqlc_fj_run)
+    struct multi_item * old = mymulti->items;
+    int na = (mymulti->alloc == 0) ? 8 : mymulti->alloc * 2;
+    struct multi_item * items = malloc(na * sizeof(struct multi_item));
+    if (items == NULL) return -SQLITE_NOMEM;
+    if (old != NULL) memcpy(items, old, mymulti->count * sizeof(struct multi_item));
+    free(old);
+    mymulti->items = items;
+    mymulti->alloc = na;
+  }
+
+  it = &mymulti->items[mymulti->count];
+  // (copy since the batch is run later)
+  it->batch_json = malloc(strlen(batch_json) + 1);
+  if (it->batch_json == NULL) return -SQLITE_NOMEM;
+  strcpy(it->batch_json, batch_json);
+  it->fj = fj;
+  it->ll = ll;
+  it->result = NULL;
+  it->next = -1;
+
+  // run after any earlier batch on the same database (a connection is used by one thread at a time):
+  for (i=mymulti->count-1; i>=0; --i) {
+    if (((struct fj_s *)HANDLE_TO_VP(mymulti->items[i].fj))->mydb == myfj->mydb) {
+      mymulti->items[i].next = mymulti->count;
+      break;
+    }
+  }
+
+  return mymulti->count++;
+}
+
+static void * multi_worker(void * arg)
+{
+  struct multi_s * mymulti = arg;
+  int t;
+
+  while ((t = __atomic_fetch_add(&mymulti->next_task, 1, __ATOMIC_RELAXED)) < mymulti->task_count) {
+    int i;
+    for (i=mymulti->tasks[t]; i>=0; i=mymulti->items[i].next) {
+      struct multi_item * it = &mymulti->items[i];
+      it->result = sqlc_fj_run(it->fj, it->batch_json, it->ll);
+    }
+  }
+
+  return NULL;
+}
+
+static void multi_clear(struct multi_s * mymulti)
+{
+  int i;
+  for (i=0; i<mymulti->count; ++i) free(mymulti->items[i].batch_json);
+  mymulti->count = 0;
+  free(mymulti->tasks);
+  mymulti->tasks = NULL;
+  mymulti->task_count = 0;
+}
+
+const char *sqlc_multi_run(sqlc_handle_t multi)
+{
+  struct multi_s * mymulti = HANDLE_TO_VP(multi);
+  pthread_t * threads = NULL;
+  int nthreads = 0;
+  size_t rl = 2;
+  char * rr;
+  int i, j;
+
+  MYLOG("%s %p %d", __func__, mymulti, mymulti->count);
+
+  free(mymulti->result);
+  mymulti->result = NULL;
+
+  mymulti->tasks = malloc((mymulti->count + 1) * sizeof(int));
+  if (mymulti->tasks == NULL) goto multimemoryerror;
+
+  // one task for the first batch on each database:
+  for (i=0; i<mymulti->count; ++i) {
+    bool first = true;
+    for (j=0; j<i && first; ++j)
+      if (mymulti->items[j].next == i) first = false;
+    if (first) mymulti->tasks[mymulti->task_count++] = i;
+  }
+  mymulti->next_task = 0;
+
+  // the calling thread is one of the workers:
+  nthreads = ((mymulti->task_count < mymulti->max_threads) ? mymulti->task_count : mymulti->max_threads) - 1;
+  if (nthreads > 0) {
+    threads = malloc(nthreads * sizeof(pthread_t));
+    if (threads == NULL) nthreads = 0;
+  }
+  for (i=0; i<nthreads; ++i) {
+    if (pthread_create(&threads[i], NULL, multi_worker, mymulti) != 0) break;
+  }
+  nthreads = i;
+
+  multi_worker(mymulti);
+
+  for (i=0; i<nthreads; ++i) pthread_join(threads[i], NULL);
+  free(threads);
+
+  // all results in order: [result0,result1,...]
+  for (i=0; i<mymulti->count; ++i) rl += strlen(mymulti->items[i].result) + 1;
+
+  mymulti->result = rr = malloc(rl + 1);
+  if (rr == NULL) goto multimemoryerror;
+
+  strcpy(rr, "[");
+  rl = 1;
+  for (i=0; i<mymulti->count; ++i) {
+    if (i > 0) rr[rl++] = ',';
+    strcpy(rr+rl, mymulti->items[i].result);
+    rl += strlen(rr+rl);
+  }
+  strcpy(rr+rl, "]");
+
+  multi_clear(mymulti);
+  return rr;
+
+multimemoryerror:
+  multi_clear(mymulti);
+  return "{\"message\": \"memory error\"}";
+}
+
+void sqlc_multi_dispose(sqlc_handle_t multi)
+{
+  struct multi_s * mymulti = HANDLE_TO_VP(multi);
+
+  MYLOG("%s %p", __func__, mymulti);
+
+  multi_clear(mymulti);
+  free(mymulti->items);
+  free(mymulti->result);
+  free(mymulti);
+}
+
+// Memory limits & release:
+
+sqlc_long_t sqlc_soft_heap_limit(sqlc_long_t n)
+{
+  MYLOG("%s %lld", __func__, n);
+
+  return sqlite3_soft_heap_limit64(n);
+}
+
+sqlc_long_t sqlc_hard_heap_limit(sqlc_long_t n)
+{
+  MYLOG("%s %lld", __func__, n);
+
+  return sqlite3_hard_heap_limit64(n);
+}
+
+sqlc_long_t sqlc_db_release_memory(sqlc_handle_t db)
+{
+  sqlite3 *mydb = HANDLE_TO_VP(db);
+  int before = 0, after = 0, hi = 0;
+  sqlc_long_t n;
+  int rv;
+
+  MYLOG("%s %p", __func__, mydb);
+
+  n = fj_trim_all(mydb);
+
+  sqlite3_db_status(mydb, SQLITE_DBSTATUS_CACHE_USED, &before, &hi, 0);
+  rv = sqlite3_db_release_memory(mydb);
+  if (rv != SQLITE_OK) return -rv;
+  sqlite3_db_status(mydb, SQLITE_DBSTATUS_CACHE_USED, &after, &hi, 0);
+
+  return n + ((before > after) ? before - after : 0);
+}
+
+sqlc_long_t sqlc_release_memory(void)
+{
+  MYLOG("%s", __func__);
+
+  // NOTE: sqlite3_release_memory() frees nothing unless built with SQLITE_ENABLE_MEMORY_MANAGEMENT
+  return fj_trim_all(NULL) + sqlite3_release_memory(INT_MAX);
+}
+
+int sqlc_memory_stats(void *buf, int len)
+{
+  sqlc_long_t v[SQLC_MEM_STAT_COUNT];
+  int n = len / sizeof(sqlc_long_t);
+  struct fj_s *myfj;
+
+  MYLOG("%s %d", __func__, len);
+
+  if (buf == NULL) return -SQLITE_MISUSE;
+  if (n > SQLC_MEM_STAT_COUNT) n = SQLC_MEM_STAT_COUNT;
+
+  v[SQLC_MEM_STAT_USED] = sqlite3_memory_used();
+  v[SQLC_MEM_STAT_HIGHWATER] = sqlite3_memory_highwater(0);
+  v[SQLC_MEM_STAT_SOFT_LIMIT] = sqlite3_soft_heap_limit64(-1);
+  v[SQLC_MEM_STAT_HARD_LIMIT] = sqlite3_hard_heap_limit64(-1);
+  v[SQLC_MEM_STAT_FJ_RETAINED] = 0;
+
+  pthread_mutex_lock(&fj_list_mutex);
+  for (myfj = fj_list; myfj != NULL; myfj = myfj->list_next)
+    if (!myfj->busy) v[SQLC_MEM_STAT_FJ_RETAINED] += fj_retained(myfj);
+  pthread_mutex_unlock(&fj_list_mutex);
+
+  memcpy(buf, v, n * sizeof(sqlc_long_t));
+  return n;
+}
+
+// Time-boxed maintenance:
+
+// pages per incremental vacuum step (as a string)
+#define MAINTAIN_VACUUM_SLICE "128"
+
+static int maintain_progress(void * p)
+{
+  return fj_now_ms() >= *(sqlc_long_t *)p;
+}
+
+static sqlc_long_t maintain_freelist(sqlite3 * mydb)
+{
+  sqlite3_stmt * s = NULL;
+  sqlc_long_t n = 0;
+
+  if (sqlite3_prepare_v2(mydb, "PRAGMA main.freelist_count", -1, &s, NULL) == SQLITE_OK &&
+      sqlite3_step(s) == SQLITE_ROW)
+    n = sqlite3_column_int64(s, 0);
+  sqlite3_finalize(s);
+  return n;
+}
+
+int sqlc_db_maintain(sqlc_handle_t db, int budget_ms, int flags, void *stats, int len)
+{
+  sqlite3 *mydb = HANDLE_TO_VP(db);
+  sqlc_long_t v[SQLC_MAINTAIN_STAT_COUNT] = { -1, -1, 0, 0, 0 };
+  int n = len / sizeof(sqlc_long_t);
+  sqlc_long_t t0 = fj_now_ms();
+  sqlc_long_t deadline = t0 + budget_ms;
+  int rv = SQLITE_OK;
+
+  MYLOG("%s %p %d %d", __func__, mydb, budget_ms, flags);
+
+  if (budget_ms <= 0) return SQLITE_MISUSE;
+  if (n > SQLC_MAINTAIN_STAT_COUNT) n = SQLC_MAINTAIN_STAT_COUNT;
+
+  // stop any statement (rolled back) once the budget runs out:
+  sqlite3_progress_handler(mydb, FJ_PROGRESS_OPS, maintain_progress, &deadline);
+
+  if (flags & (SQLC_MAINTAIN_CHECKPOINT | SQLC_MAINTAIN_CHECKPOINT_RESTART)) {
+    int log = -1, ckpt = -1;
+
+    rv = sqlite3_wal_checkpoint_v2(mydb, NULL, SQLITE_CHECKPOINT_PASSIVE, &log, &ckpt);
+
+    // (a restart checkpoint may wait for readers in the busy handler of the connection)
+    if (rv == SQLITE_OK && (flags & SQLC_MAINTAIN_CHECKPOINT_RESTART) && log > 0 && log == ckpt &&
+        fj_now_ms() < deadline) {
+      rv = sqlite3_wal_checkpoint_v2(mydb, NULL, SQLITE_CHECKPOINT_RESTART, &log, &ckpt);
+      if (rv == SQLITE_BUSY) rv = SQLITE_OK;
+    }
+
+    v[SQLC_MAINTAIN_STAT_WAL_FRAMES] = log;
+    v[SQLC_MAINTAIN_STAT_CHECKPOINTED] = ckpt;
+  }
+
+  if (rv == SQLITE_OK && (flags & SQLC_MAINTAIN_VACUUM)) {
+    // (does nothing unless PRAGMA auto_vacuum=INCREMENTAL)
+    sqlc_long_t fl = maintain_freelist(mydb);
+
+    while (rv == SQLITE_OK && fl > 0 && fj_now_ms() < deadline) {
+      sqlc_long_t fl2;
+
+      rv = sqlite3_exec(mydb, "PRAGMA main.incremental_vacuum(" MAINTAIN_VACUUM_SLICE ")", NULL, NULL, NULL);
+      fl2 = maintain_freelist(mydb);
+      if (fl2 >= fl) break;
+      v[SQLC_MAINTAIN_STAT_PAGES_FREED] += fl - fl2;
+      fl = fl2;
+    }
+
+    v[SQLC_MAINTAIN_STAT_FREELIST] = fl;
+  }
+
+  if (rv == SQLITE_OK && (flags & SQLC_MAINTAIN_OPTIMIZE) && fj_now_ms() < deadline) {
+    rv = sqlite3_exec(mydb, "PRAGMA main.optimize", NULL, NULL, NULL);
+  }
+
+  sqlite3_progress_handler(mydb, 0, NULL, NULL);
+
+  // budget used up before all of the work was done:
+  if (rv == SQLITE_OK && fj_now_ms() >= deadline) rv = SQLITE_INTERRUPT;
+
+  v[SQLC_MAINTAIN_STAT_MS] = fj_now_ms() - t0;
+
+  if (stats != NULL && n > 0) memcpy(stats, v, n * sizeof(sqlc_long_t));
+  return rv;
+}
 
-  // not needed here:
-  // "check" first SQL:
-  if (tokn->type != JSMN_STRING) return "{\"message\": \"type error 7\"}";
+// Temp store:
 
-  myfj->cleanup2 = rr = malloc(arlen = FIRST_ALLOC);
-  if (rr == NULL) goto batchmemoryerror;
+int sqlc_temp_directory(const char *dir)
+{
+  char * d = NULL;
 
-  strcpy(rr, "[");
-  rrlen = 1;
+  MYLOG("%s %s", __func__, dir);
 
-  for (fi=0; fi<flen; ++fi) {
-    int tc0 = sqlite3_total_changes(mydb);
+  if (dir != NULL) {
+    d = sqlite3_mprintf("%s", dir);
+    if (d == NULL) return SQLITE_NOMEM;
+  }
 
-    //if (tokn->type != JSMN_STRING) return "{\"message\": \"type error (sql)\"}";
-    //if (tokn->type != JSMN_STRING && tokn->type != JSMN_PRIMITIVE) return "{\"message\": \"type error (sql)\"}";
-    if (tokn->type != JSMN_STRING) return batch_json+tokn->start;
-    //rv = sqlite3_prepare_v2(mydb, batch_json+tokn->start, tokn->end-tokn->start, &s, NULL);
-    {
-      // XXX FUTURE TBD keep buffer & free at the end
-      int te = tokn->end;
-      int tl = tokn->end-tokn->start;
-      char * a = malloc(tl+100); // extra padding
-      int ai = (a == NULL) ? -1 : sj(batch_json+tokn->start, tl, a);
-      if (a == NULL) goto batchmemoryerror;
-      rv = sqlite3_prepare_v2(mydb, a, ai, &s, NULL);
-      free(a);
-    }
-    ++tokn;
-    // TODO check rv
+  sqlite3_free(sqlite3_temp_directory);
+  sqlite3_temp_directory = d;
+  return SQLITE_OK;
+}
 
-    // TODO deal with bind count
-    //if (tokn->type != JSMN_PRIMITIVE) return "{\"message\": \"xxxx\"}";
-    //if (tokn->type != JSMN_PRIMITIVE) return batch_json+tokn->start;
-    if (tokn->type != JSMN_PRIMITIVE) return "{\"message\": \"xxxx\"}";
-    nflen = tokn->end-tokn->start;
-    strncpy(nf, batch_json+tokn->start, nflen);
-    nf[nflen] = '\0';
-    param_count = atoi(nf);
-    ++tokn;
+int sqlc_db_temp_store(sqlc_handle_t db, int mode, sqlc_long_t spill_bytes)
+{
+  sqlite3 *mydb = HANDLE_TO_VP(db);
+  char sql[64];
+  int rv;
 
-    //tokn = tokn + param_count;// XXX TEMP TEST
+  MYLOG("%s %p %d %lld", __func__, mydb, mode, spill_bytes);
 
-    // XXX TODO OVERFLOW ETC ETC
+  if (mode < SQLC_TEMP_STORE_DEFAULT || mode > SQLC_TEMP_STORE_MEMORY) return SQLITE_MISUSE;
 
-    if (rv != SQLITE_OK) {
-      tokn = tokn + param_count;
-    } else {
-      for (bi=1; bi<=param_count; ++bi) {
-        // XXX TODO deal with BLOB etc etc
-        // XXX TBD/TODO check bind result??
-        if (tokn->type == JSMN_PRIMITIVE) {
-          // XXX TODO double-check:
-          // XXX TODO TEST ALL:
-          if (batch_json[tokn->start] == 'n') {
-            sqlite3_bind_null(s, bi);
-          } else if (batch_json[tokn->start] == 't') {
-            sqlite3_bind_int(s, bi, 1);
-          } else if (batch_json[tokn->start] == 'f') {
-            sqlite3_bind_int(s, bi, 0);
-          } else {
-            bool f=false;
-            int iii;
+  // (closes the temp database of the connection if the mode changes)
+  snprintf(sql, sizeof sql, "PRAGMA temp_store=%d", mode);
+  rv = sqlite3_exec(mydb, sql, NULL, NULL, NULL);
 
-            for (iii=tokn->start; iii!=tokn->end; ++iii) {
-              if (batch_json[iii]=='.') {
-                f = true;
-                break;
-              }
-            }
+  if (rv == SQLITE_OK && spill_bytes > 0) {
+    // negative cache_size is in KiB; a sort keeps up to the cache size of main in memory
+    // (the ephemeral b-trees of DISTINCT etc. always use SQLITE_DEFAULT_CACHE_SIZE):
+    snprintf(sql, sizeof sql, "PRAGMA main.cache_size=%lld; PRAGMA temp.cache_size=%lld",
+      -((spill_bytes + 1023) / 1024), -((spill_bytes + 1023) / 1024));
+    rv = sqlite3_exec(mydb, sql, NULL, NULL, NULL);
+  }
 
-            nflen = tokn->end-tokn->start;
-            strncpy(nf, batch_json+tokn->start, nflen);
-            nf[nflen] = '\0';
+  return rv;
+}
 
-            if (f) {
-              sqlite3_bind_double(s, bi, atof(nf));
-            } else {
-              sqlite3_bind_int64(s, bi, atoll(nf));
-            }
-          }
-        } else {
-          // XXX FUTURE TBD keep buffer & free at the end
-          //sqlite3_bind_text(s, bi, batch_json+tokn->start, tokn->end-tokn->start, SQLITE_TRANSIENT);
-          int te = tokn->end;
-          int tl = tokn->end-tokn->start;
-          char * a = malloc(tl+100); // extra padding
-          int ai = (a==NULL) ? -1 : sj(batch_json+tokn->start, tl, a);
-          if (a == NULL) goto batchmemoryerror1;
-          sqlite3_bind_text(s, bi, a, ai, SQLITE_TRANSIENT);
-          free(a);
-        }
-        ++tokn;
-      }
+// Session extension (compiled out unless built with -DSQLITE_ENABLE_SESSION):
 
-      rv=sqlite3_step(s);
-      if (rv == SQLITE_ROW) {
-        strcpy(rr+rrlen, "\"okrows\",");
-        rrlen += 9;
-        do {
-          cc = sqlite3_column_count(s);
-          sprintf(nf, "%d", cc);
-          strcpy(rr+rrlen, nf);
-          rrlen += strlen(nf);
-          strcpy(rr+rrlen, ",");
-          ++rrlen;
+#ifdef SQLITE_ENABLE_SESSION
+struct session_out {
+  char * buf;
+  int len;
+  sqlc_long_t size;
+};
 
-          for (jj=0; jj<cc; ++jj) {
-            int ct = sqlite3_column_type(s, jj);
+static int session_output(void * p, const void * data, int n)
+{
+  struct session_out * out = p;
 
-            strcpy(rr+rrlen, "\"");
-            rrlen += 1;
-            pptext = sqlite3_column_name(s, jj);
-            pplen = strlen(pptext);
-            if (rrlen + pplen + NEXT_ALLOC > arlen) {
-              char * old = rr;
-              arlen += EXTRA_ALLOC + pplen + NEXT_ALLOC;
-              //myfj->cleanup2 = rr = realloc(rr, arlen);
-              myfj->cleanup2 = rr = malloc(arlen);
-              if (rr != NULL) memcpy(rr, old, rrlen);
-              free(old);
-              if (rr == NULL) goto batchmemoryerror1;
-            }
-            strcpy(rr+rrlen, pptext);
-            rrlen += pplen;
-            strcpy(rr+rrlen, "\",");
-            rrlen += 2;
+  // copy the chunks while they fit, only the size is counted once one does not fit
+  // (the chunks before it are left in the buffer):
+  if (out->size + n <= out->len) memcpy(out->buf + out->size, data, n);
+  out->size += n;
+  return SQLITE_OK;
+}
 
-            if (ct == SQLITE_NULL) {
-              // XXX TODO TEST ME
-              strcpy(rr+rrlen, "null,");
-              rrlen += 5;
-            } else {
-              pptext = sqlite3_column_text(s, jj);
-              pplen = strlen(pptext);
-              //pplen = 0;
-              //while(pptext[pplen] != 0) ++pplen;
+struct changeset_apply {
+  int policy;
+  sqlc_long_t counts[SQLC_CHANGESET_STAT_COUNT];
+};
 
-              // NOTE: add double pplen for JSON encoding
-              if (rrlen + pplen + pplen + NEXT_ALLOC > arlen) {
-                char * old = rr;
-                arlen += EXTRA_ALLOC + pplen + pplen + NEXT_ALLOC;
-                //myfj->cleanup2 = rr = realloc(rr, arlen);
-                myfj->cleanup2 = rr = malloc(arlen);
-                if (rr != NULL) memcpy(rr, old, rrlen);
-                free(old);
-                if (rr == NULL) goto batchmemoryerror1;
-              }
+static int changeset_conflict(void * p, int type, sqlite3_changeset_iter * it)
+{
+  struct changeset_apply * ca = p;
 
-              if (ct == SQLITE_INTEGER || ct == SQLITE_FLOAT) {
-                strcpy(rr+rrlen, pptext);
-                rrlen += pplen;
-                strcpy(rr+rrlen, ",");
-                rrlen += 1;
-              } else {
-                int pi=0;
-                // XXX FUTURE TODO handle BLOB correctly
-                // XXX TBD CHECK PROPER JSON ??
-                strcpy(rr+rrlen, "\"");
-                rrlen += 1;
-                //strcpy(rr+rrlen, pptext);
-                //rrlen += pplen;
-                while (pi < pplen) {
-                  int pc = pptext[pi];
-
-                  if (pc == '\\') {
-                    rr[rrlen++] = '\\';
-                    rr[rrlen++] = '\\';
-                    pi += 1;
-                  } else if (pc == '\"') {
-                    rr[rrlen++] = '\\';
-                    rr[rrlen++] = '\"';
-                    pi += 1;
-                  } else if (pc >= 32 && pc < 127) {
-                    rr[rrlen++] = pptext[pi++];
-                  } else if (pc > 0xe0) {
-                    //sprintf(rr+rrlen, ".%02x.%02x.%02x.", pc, pptext[pi+1], pptext[pi+2]);
-                    //rrlen += strlen(rr+rrlen);
-                    //pi += 3;
-                    rr[rrlen++] = pptext[pi++];
-                    rr[rrlen++] = pptext[pi++];
-                    rr[rrlen++] = pptext[pi++];
-                  } else if (pc >= 0xc0) {
-                    //sprintf(rr+rrlen, ".%02x.%02x.", pc, pptext[pi+1]);
-                    //rrlen += strlen(rr+rrlen);
-                    //pi += 2;
-                    rr[rrlen++] = pptext[pi++];
-                    rr[rrlen++] = pptext[pi++];
-                  } else if (pc >= 128) {
-                    // XXX TBD ???:
-                    sprintf(rr+rrlen, "-%02x-", pc);
-                    rrlen += strlen(rr+rrlen);
-                    pi += 1;
-                  } else if (pc == '\t') {
-                    rr[rrlen++] = '\\';
-                    rr[rrlen++] = 't';
-                    pi += 1;
-                  } else if (pc == '\r') {
-                    rr[rrlen++] = '\\';
-                    rr[rrlen++] = 'r';
-                    pi += 1;
-                  } else if (pc == '\n') {
-                    rr[rrlen++] = '\\';
-                    rr[rrlen++] = 'n';
-                    pi += 1;
-                  } else {
-                    sprintf(rr+rrlen, "?%02x?", pc);
-                    rrlen += strlen(rr+rrlen);
-                    pi += 1;
-                  }
-                }
-                strcpy(rr+rrlen, "\",");
-                rrlen += 2;
-              }
-            }
-          }
-          rv=sqlite3_step(s);
-        } while (rv == SQLITE_ROW);
-        strcpy(rr+rrlen, "\"endrows\",");
-        rrlen += 10;
-      } else if (rv == SQLITE_OK || rv == SQLITE_DONE) {
-        int rowsAffected = sqlite3_total_changes(mydb) - tc0;
+  if (type >= SQLITE_CHANGESET_DATA && type <= SQLITE_CHANGESET_FOREIGN_KEY)
+    ++ca->counts[type - SQLITE_CHANGESET_DATA];
 
-        //if (rrlen + 40 + NEXT_ALLOC > arlen)
-        if (rrlen + 200 > arlen) {
-          char * old = rr;
-          //arlen += EXTRA_ALLOC + 40 + NEXT_ALLOC;
-          arlen += EXTRA_ALLOC + 200 + 50;
-          //myfj->cleanup2 = rr = realloc(rr, arlen);
-          myfj->cleanup2 = rr = malloc(arlen);
-          if (rr != NULL) memcpy(rr, old, rrlen);
-          free(old);
-          if (rr == NULL) goto batchmemoryerror1;
-        }
+  if (ca->policy == SQLC_CHANGESET_ABORT) return SQLITE_CHANGESET_ABORT;
+  // (REPLACE is only allowed for these)
+  if (type == SQLITE_CHANGESET_DATA || type == SQLITE_CHANGESET_CONFLICT) return ca->policy;
+  return SQLITE_CHANGESET_OMIT;
+}
+#endif
 
-        if (rowsAffected > 0) {
-          int insertId = sqlite3_last_insert_rowid(mydb);
+sqlc_handle_t sqlc_db_session_new(sqlc_handle_t db, const char *schema)
+{
+#ifdef SQLITE_ENABLE_SESSION
+  sqlite3 *mydb = HANDLE_TO_VP(db);
+  sqlite3_session * s = NULL;
+  int rv;
 
-          strcpy(rr+rrlen, "\"ch2\",");
-          rrlen += 6;
+  MYLOG("%s %p %s", __func__, mydb, schema);
 
-          sprintf(nf, "%d", rowsAffected);
-          strcpy(rr+rrlen, nf);
-          rrlen += strlen(nf);
-          strcpy(rr+rrlen, ",");
-          ++rrlen;
+  rv = sqlite3session_create(mydb, (schema == NULL) ? "main" : schema, &s);
+  if (rv != SQLITE_OK) return -rv;
 
-          sprintf(nf, "%d", insertId);
-          strcpy(rr+rrlen, nf);
-          rrlen += strlen(nf);
-          strcpy(rr+rrlen, ",");
-          ++rrlen;
-        } else {
-          strcpy(rr+rrlen, "\"ok\",");
-          rrlen += 5;
-        }
-      }
-    }
+  return HANDLE_FROM_VP(s);
+#else
+  return -SQLITE_ERROR;
+#endif
+}
 
-    if (rv != SQLITE_OK && rv != SQLITE_DONE) {
-      if (rrlen + 200 > arlen) {
-        char * old = rr;
-        //arlen += EXTRA_ALLOC + 40 + NEXT_ALLOC;
-        arlen += EXTRA_ALLOC + 200 + 50;
-        //myfj->cleanup2 = rr = realloc(rr, arlen);
-        myfj->cleanup2 = rr = malloc(arlen);
-        if (rr != NULL) memcpy(rr, old, rrlen);
-        free(old);
-        if (rr == NULL) goto batchmemoryerror1;
-      }
+int sqlc_session_attach(sqlc_handle_t session, const char *table)
+{
+#ifdef SQLITE_ENABLE_SESSION
+  sqlite3_session * s = HANDLE_TO_VP(session);
 
-      // XXX TODO REPORT CORRECT ERROR
-      strcpy(rr+rrlen, "\"error\",0,1,\"--\",");
-      rrlen += 17;
-    }
+  MYLOG("%s %p %s", __func__, s, table);
 
-    // FUTURE TODO what to do in case this returns an error
-    sqlite3_finalize(s);
+  return sqlite3session_attach(s, table);
+#else
+  return SQLITE_ERROR;
+#endif
+}
 
-#if 0 // NO NEEDED BEFORE ADDING SQL STATEMENT RESULT
-    // TODO explain why:
-    if (rrlen + 40 + NEXT_ALLOC > arlen) {
-      //arlen += EXTRA_ALLOC + 40 + NEXT_ALLOC;
-      arlen = arlen + arlen + rrlen + 200;
-      myfj->cleanup2 = rr = realloc(rr, arlen);
-      if (rr == NULL) goto batchmemoryerror1;
-    }
+int sqlc_session_enable(sqlc_handle_t session, int enable)
+{
+#ifdef SQLITE_ENABLE_SESSION
+  sqlite3_session * s = HANDLE_TO_VP(session);
+
+  MYLOG("%s %p %d", __func__, s, enable);
+
+  return sqlite3session_enable(s, enable);
+#else
+  return -SQLITE_ERROR;
 #endif
-  }
+}
 
-  strcpy(rr+rrlen, "\"bogus\"]");
+int sqlc_session_changeset(sqlc_handle_t session, int patchset, void *buf, int len)
+{
+#ifdef SQLITE_ENABLE_SESSION
+  sqlite3_session * s = HANDLE_TO_VP(session);
+  struct session_out out = { buf, (buf == NULL) ? 0 : len, 0 };
+  int rv;
 
-  return rr;
+  MYLOG("%s %p %d %d", __func__, s, patchset, len);
 
-batchmemoryerror1:
-  // FUTURE TODO what to do in case this returns an error
-  sqlite3_finalize(s);
+  rv = patchset ? sqlite3session_patchset_strm(s, session_output, &out) :
+    sqlite3session_changeset_strm(s, session_output, &out);
+  if (rv != SQLITE_OK) return -rv;
+  if (out.size > INT_MAX) return -SQLITE_TOOBIG;
 
-batchmemoryerror:
-  free(myfj->cleanup1);
-  myfj->cleanup1 = NULL;
-  free(myfj->cleanup2);
-  myfj->cleanup2 = NULL;
+  return out.size;
+#else
+  return -SQLITE_ERROR;
+#endif
+}
 
-  return "[\"batcherror\", \"memory error\", \"bogus\"]";
+int sqlc_session_delete(sqlc_handle_t session)
+{
+#ifdef SQLITE_ENABLE_SESSION
+  sqlite3_session * s = HANDLE_TO_VP(session);
+
+  MYLOG("%s %p", __func__, s);
+
+  sqlite3session_delete(s);
+  return SQLITE_OK;
+#else
+  return SQLITE_ERROR;
+#endif
+}
+
+int sqlc_db_changeset_apply(sqlc_handle_t db, const void *buf, int len, int policy, void *stats, int slen)
+{
+#ifdef SQLITE_ENABLE_SESSION
+  sqlite3 *mydb = HANDLE_TO_VP(db);
+  struct changeset_apply ca;
+  int n = slen / sizeof(sqlc_long_t);
+  int rv;
+
+  MYLOG("%s %p %d %d", __func__, mydb, len, policy);
+
+  if (buf == NULL || len < 0) return SQLITE_MISUSE;
+  if (policy < SQLC_CHANGESET_OMIT || policy > SQLC_CHANGESET_ABORT) return SQLITE_MISUSE;
+  if (n > SQLC_CHANGESET_STAT_COUNT) n = SQLC_CHANGESET_STAT_COUNT;
+
+  memset(&ca, 0, sizeof(ca));
+  ca.policy = policy;
+
+  rv = sqlite3changeset_apply(mydb, len, (void *)buf, NULL, changeset_conflict, &ca);
+
+  if (stats != NULL && n > 0) memcpy(stats, ca.counts, n * sizeof(sqlc_long_t));
+  return rv;
+#else
+  return SQLITE_ERROR;
+#endif
 }
@@ -1,7 +1,7 @@
 /* API version to check: */
 #define SQLC_API_VERSION 1
 
-/* Export some important sqlite open flags to the Java interface (VFS not supported): */
+/* Export some important sqlite open flags to the Java interface: */
 #define SQLC_OPEN_READONLY      0x00001
 #define SQLC_OPEN_READWRITE     0x00002
 #define SQLC_OPEN_CREATE        0x00004
@@ -19,6 +19,10 @@
 #define SQLC_RESULT_PERM        3
 #define SQLC_RESULT_ABORT       4
 /* TBD ... */
+#define SQLC_RESULT_INTERRUPT   9
+/* TBD ... */
+#define SQLC_RESULT_NOTFOUND    12
+/* TBD ... */
 #define SQLC_RESULT_CONSTRAINT  19
 #define SQLC_RESULT_MISMATCH    20
 #define SQLC_RESULT_MISUSE      21
@@ -33,6 +37,137 @@
 #define SQLC_BLOB       4
 #define SQLC_NULL       5
 
+/* trace event types (same as sqlite3_trace_v2()): */
+#define SQLC_TRACE_STMT     0x01
+#define SQLC_TRACE_PROFILE  0x02
+#define SQLC_TRACE_ROW      0x04
+#define SQLC_TRACE_CLOSE    0x08
+
+/* index of each value from sqlc_db_stats(),
+ * connection (sqlite3_db_status()) followed by process (sqlite3_status64()) values: */
+#define SQLC_STAT_CACHE_USED                    0
+#define SQLC_STAT_CACHE_USED_SHARED             1
+#define SQLC_STAT_CACHE_HIT                     2
+#define SQLC_STAT_CACHE_MISS                    3
+#define SQLC_STAT_CACHE_WRITE                   4
+#define SQLC_STAT_CACHE_SPILL                   5
+#define SQLC_STAT_LOOKASIDE_USED                6
+#define SQLC_STAT_LOOKASIDE_USED_HIGHWATER      7
+#define SQLC_STAT_LOOKASIDE_HIT                 8
+#define SQLC_STAT_LOOKASIDE_MISS_SIZE           9
+#define SQLC_STAT_LOOKASIDE_MISS_FULL           10
+#define SQLC_STAT_SCHEMA_USED                   11
+#define SQLC_STAT_STMT_USED                     12
+#define SQLC_STAT_MEMORY_USED                   13
+#define SQLC_STAT_MEMORY_USED_HIGHWATER         14
+#define SQLC_STAT_MALLOC_COUNT                  15
+#define SQLC_STAT_MALLOC_COUNT_HIGHWATER        16
+#define SQLC_STAT_MALLOC_SIZE_HIGHWATER         17
+#define SQLC_STAT_PAGECACHE_USED                18
+#define SQLC_STAT_PAGECACHE_OVERFLOW            19
+#define SQLC_STAT_PAGECACHE_OVERFLOW_HIGHWATER  20
+#define SQLC_STAT_PAGECACHE_SIZE_HIGHWATER      21
+#define SQLC_STAT_COUNT                         22
+
+/* index of each value from sqlc_fj_alloc_stats(), for the last run & total for the fj handle
+ * (number of allocations, bytes allocated, bytes copied to grow the result buffer, peak result buffer size): */
+#define SQLC_FJ_STAT_RUN_ALLOCS    0
+#define SQLC_FJ_STAT_RUN_BYTES     1
+#define SQLC_FJ_STAT_RUN_COPIED    2
+#define SQLC_FJ_STAT_RUN_PEAK      3
+#define SQLC_FJ_STAT_TOTAL_ALLOCS  4
+#define SQLC_FJ_STAT_TOTAL_BYTES   5
+#define SQLC_FJ_STAT_TOTAL_COPIED  6
+#define SQLC_FJ_STAT_TOTAL_PEAK    7
+#define SQLC_FJ_STAT_COUNT         8
+
+/* sqlc_db_export() formats: */
+#define SQLC_EXPORT_NDJSON  1
+#define SQLC_EXPORT_CSV     2
+
+/* index of each value from sqlc_db_export(): */
+#define SQLC_EXPORT_STAT_ROWS   0
+#define SQLC_EXPORT_STAT_BYTES  1
+#define SQLC_EXPORT_STAT_COUNT  2
+
+/* index of each value from sqlc_db_import(), followed by the row number of each failed row: */
+#define SQLC_IMPORT_STAT_ROWS      0
+#define SQLC_IMPORT_STAT_INSERTED  1
+#define SQLC_IMPORT_STAT_ERRORS    2
+#define SQLC_IMPORT_STAT_BYTES     3
+#define SQLC_IMPORT_STAT_COUNT     4
+
+/* number of rows per transaction if chunk_rows is 0 */
+#define SQLC_IMPORT_DEFAULT_CHUNK  5000
+
+/* index of each value from sqlc_db_warmup(): */
+#define SQLC_WARMUP_STAT_PAGES  0
+#define SQLC_WARMUP_STAT_BYTES  1
+#define SQLC_WARMUP_STAT_MS     2
+#define SQLC_WARMUP_STAT_COUNT  3
+
+/* name of the VFS from sqlc_range_vfs_register(): */
+#define SQLC_RANGE_VFS "sqlc_range"
+
+/* sqlc_db_deserialize() flags: */
+#define SQLC_DESERIALIZE_READONLY  0x04
+
+/* sqlc_db_register_functions() groups: */
+#define SQLC_FUNC_REGEXP  0x01
+#define SQLC_FUNC_HASH    0x02
+#define SQLC_FUNC_GEO     0x04
+#define SQLC_FUNC_ALL     0x07
+
+/* index of each value from sqlc_memory_stats() (bytes): */
+#define SQLC_MEM_STAT_USED         0
+#define SQLC_MEM_STAT_HIGHWATER    1
+#define SQLC_MEM_STAT_SOFT_LIMIT   2
+#define SQLC_MEM_STAT_HARD_LIMIT   3
+#define SQLC_MEM_STAT_FJ_RETAINED  4
+#define SQLC_MEM_STAT_COUNT        5
+
+/* sqlc_db_maintain() flags: */
+#define SQLC_MAINTAIN_CHECKPOINT          0x01
+#define SQLC_MAINTAIN_CHECKPOINT_RESTART  0x02
+#define SQLC_MAINTAIN_VACUUM              0x04
+#define SQLC_MAINTAIN_OPTIMIZE            0x08
+
+/* index of each value from sqlc_db_maintain(): */
+#define SQLC_MAINTAIN_STAT_WAL_FRAMES    0
+#define SQLC_MAINTAIN_STAT_CHECKPOINTED  1
+#define SQLC_MAINTAIN_STAT_PAGES_FREED   2
+#define SQLC_MAINTAIN_STAT_FREELIST      3
+#define SQLC_MAINTAIN_STAT_MS            4
+#define SQLC_MAINTAIN_STAT_COUNT         5
+
+/* max number of distinct tables with an id in one change feed: */
+#define SQLC_CHANGES_MAX_TABLES  256
+
+/* sqlc_db_temp_store() modes (same as PRAGMA temp_store): */
+#define SQLC_TEMP_STORE_DEFAULT  0
+#define SQLC_TEMP_STORE_FILE     1
+#define SQLC_TEMP_STORE_MEMORY   2
+
+/* sqlc_db_changeset_apply() conflict policy (same as the conflict handler results): */
+#define SQLC_CHANGESET_OMIT     0
+#define SQLC_CHANGESET_REPLACE  1
+#define SQLC_CHANGESET_ABORT    2
+
+/* index of each conflict count from sqlc_db_changeset_apply() (conflict type - 1): */
+#define SQLC_CHANGESET_STAT_DATA         0
+#define SQLC_CHANGESET_STAT_NOTFOUND     1
+#define SQLC_CHANGESET_STAT_CONFLICT     2
+#define SQLC_CHANGESET_STAT_CONSTRAINT   3
+#define SQLC_CHANGESET_STAT_FOREIGN_KEY  4
+#define SQLC_CHANGESET_STAT_COUNT        5
+
+/* index of each value from sqlc_busy_profile_stats(): */
+#define SQLC_BUSY_STAT_EVENTS    0
+#define SQLC_BUSY_STAT_RETRIES   1
+#define SQLC_BUSY_STAT_WAIT_NS   2
+#define SQLC_BUSY_STAT_TIMEOUTS  3
+#define SQLC_BUSY_STAT_COUNT     4
+
 /* Could not easily get int64_t from stddef.h for gluegen */
 typedef long long sqlc_long_t;
 
@@ -48,8 +183,15 @@ sqlc_handle_t sqlc_api_db_open(int sqlc_api_version, const char *filename, int f
 
 sqlc_handle_t sqlc_db_open(const char *filename, int flags);
 
-// FUTURE TBD (???):
-//sqlc_handle_t sqlc_db_open_vfs(const char *filename, int flags, const char *vfs);
+/* Open with a registered VFS by name (NULL for the default VFS): */
+sqlc_handle_t sqlc_db_open_vfs(const char *filename, int flags, const char *vfs);
+
+/* Register the bundled read-only VFS (SQLC_RANGE_VFS) that reads a database in place from a range
+ * of a larger file (such as a stored zip entry) using mmap(), for example:
+ *   sqlc_db_open_vfs("file:/path/app.apk?offset=1234&length=5678", SQLC_OPEN_READONLY | SQLC_OPEN_URI, SQLC_RANGE_VFS)
+ * (length 0 or missing for the rest of the file). Use PRAGMA mmap_size to read the pages without copying.
+ * Journal & temporary files use the default VFS; WAL mode is not supported. */
+int sqlc_range_vfs_register(void);
 
 // FUTURE TBD (???) for sqlcipher:
 //  int sqlc_db_key_bytes(sqlc_handle_t db, unsigned char *key_bytes, int num_bytes);
@@ -63,6 +205,7 @@ sqlc_handle_t sqlc_db_prepare_st(sqlc_handle_t db, const char *sql);
 
 sqlc_long_t sqlc_db_last_insert_rowid(sqlc_handle_t db);
 int sqlc_db_total_changes(sqlc_handle_t db);
+sqlc_long_t sqlc_db_total_changes64(sqlc_handle_t db);
 
 int sqlc_db_errcode(sqlc_handle_t db);
 const char * sqlc_db_errmsg_native(sqlc_handle_t db);
@@ -78,6 +221,13 @@ int sqlc_st_bind_null(sqlc_handle_t st, int pos);
 int sqlc_st_bind_text_native(sqlc_handle_t st, int col, const char *val);
 // FUTURE TBD: bind text in UTF-16 format to SKIP the conversion
 //  int sqlc_st_bind_text_string(sqlc_handle_t st, int col, const char *val);
+/* Bind parameters 1, 2, ... from a packed direct buffer of len bytes in one call.
+ * Each value is an int32 type (SQLC_*) followed by (native byte order, not aligned):
+ *   SQLC_INTEGER: int64, SQLC_FLOAT: double,
+ *   SQLC_TEXT (UTF-8) or SQLC_BLOB: int32 length & the bytes, SQLC_NULL: nothing
+ * Parameters after the last value keep their bindings.
+ * Returns SQLC_RESULT_MISUSE for a malformed buffer, else the first bind error. */
+int sqlc_st_bind_all(sqlc_handle_t st, const void *buf, int len);
 
 int sqlc_st_step(sqlc_handle_t st);
 
@@ -94,12 +244,238 @@ const char *sqlc_st_column_text_native(sqlc_handle_t st, int col);
 // FUTURE TBD: get text in UTF-16 format to SKIP the conversion
 //  const char *sqlc_st_column_text_string(sqlc_handle_t st, int col);
 
+int sqlc_st_reset(sqlc_handle_t st); /* call sqlite3_reset(), keeps the bindings */
+int sqlc_st_clear_bindings(sqlc_handle_t st); /* set all parameters to NULL */
+
 int sqlc_st_finish(sqlc_handle_t st); /* call sqlite3_finalize() */
 
+/* Incremental BLOB I/O (sqlite3_blob_open() etc.) to read/write a large value in pieces.
+ * Use flags=0 for read-only or 1 for read/write access.
+ * A value to be written in pieces should be allocated first, e.g. with zeroblob(N). */
+sqlc_handle_t sqlc_blob_open(sqlc_handle_t db, const char *db_name, const char *table, const char *column, sqlc_long_t row, int flags);
+int sqlc_blob_bytes(sqlc_handle_t blob);
+/* Read/write n bytes at the given offset within the BLOB to/from a direct buffer: */
+int sqlc_blob_read(sqlc_handle_t blob, void *buf, int n, int offset);
+int sqlc_blob_write(sqlc_handle_t blob, const void *buf, int n, int offset);
+/* Move an open BLOB handle to another row in the same table: */
+int sqlc_blob_reopen(sqlc_handle_t blob, sqlc_long_t row);
+int sqlc_blob_close(sqlc_handle_t blob);
+
+/* Online backup (sqlite3_backup_init() etc.), also to/from an in-memory database.
+ * Use db_name NULL for "main". Call sqlc_backup_step() with a limited number of pages
+ * per step (negative for all remaining pages) until it returns SQLC_RESULT_DONE. */
+sqlc_handle_t sqlc_backup_init(sqlc_handle_t dest_db, const char *dest_name, sqlc_handle_t src_db, const char *src_name);
+int sqlc_backup_step(sqlc_handle_t backup, int pages);
+int sqlc_backup_remaining(sqlc_handle_t backup);
+int sqlc_backup_pagecount(sqlc_handle_t backup);
+int sqlc_backup_finish(sqlc_handle_t backup);
+
+/* Low-overhead tracing of the events in mask (SQLC_TRACE_*) into a fixed-size ring of
+ * capacity events (rounded up to a power of 2), using sqlite3_trace_v2().
+ * Each event is 32 bytes in native byte order:
+ *   int64 time (ns, CLOCK_MONOTONIC), int64 statement handle (db handle for CLOSE),
+ *   int64 value (PROFILE: elapsed ns, STMT: hash of the SQL text, else 0), int32 type, int32 0
+ * Events that do not fit in a full ring are dropped (& counted).
+ * One thread may drain the ring while another thread uses the db. */
+sqlc_handle_t sqlc_db_trace_start(sqlc_handle_t db, int mask, int capacity);
+/* Move up to len bytes of whole events to a direct buffer & return the number of bytes: */
+int sqlc_trace_drain(sqlc_handle_t trace, void *buf, int len);
+sqlc_long_t sqlc_trace_dropped(sqlc_handle_t trace);
+/* Stop tracing & free the ring, must be called before sqlc_db_close(): */
+int sqlc_trace_stop(sqlc_handle_t trace);
+
+/* Change feed of the rows written by committed transactions, into a fixed-size ring of
+ * capacity changes (rounded up to a power of 2), using sqlite3_update_hook().
+ * Changes are only visible to sqlc_changes_drain() once the commit hook has run
+ * & are discarded by the rollback hook. Each change is 16 bytes in native byte order:
+ *   int64 rowid, int32 op (SQLITE_INSERT, SQLITE_UPDATE or SQLITE_DELETE), int32 table id
+ * Table id -1 means more than SQLC_CHANGES_MAX_TABLES distinct tables were changed.
+ * Changes that do not fit in a full ring are dropped (& counted).
+ * Like sqlite3_update_hook(): no changes for WITHOUT ROWID tables, REPLACE conflicts,
+ * or the truncate optimization; ROLLBACK TO a savepoint does not discard changes & neither does
+ * a statement that fails inside an explicit transaction: the statement is undone but its changes made
+ * before the error (such as the rows before a UNIQUE conflict of a multi-row INSERT) are published by COMMIT.
+ * Changes are published when the commit starts: if the commit then fails (such as SQLITE_BUSY), the
+ * transaction stays open but its changes may already have been drained & a later ROLLBACK does not withdraw them.
+ * Replaces any commit, rollback & update hook of the db.
+ * One thread may drain the ring while another thread uses the db. */
+sqlc_handle_t sqlc_db_changes_start(sqlc_handle_t db, int capacity);
+/* Move up to len bytes of whole changes to a direct buffer & return the number of bytes: */
+int sqlc_changes_drain(sqlc_handle_t changes, void *buf, int len);
+sqlc_long_t sqlc_changes_dropped(sqlc_handle_t changes);
+/* Name of a table id ("schema.table" if not in "main"), NULL if not (yet) known: */
+const char *sqlc_changes_table_name(sqlc_handle_t changes, int id);
+/* Stop the change feed & free the ring, must be called before sqlc_db_close(): */
+int sqlc_changes_stop(sqlc_handle_t changes);
+
+/* Lock-wait profiling: busy handler that retries up to timeout_ms like sqlite3_busy_timeout()
+ * (replaces any busy handler or timeout of the db) & counts the lock conflicts. */
+sqlc_handle_t sqlc_db_busy_profile_start(sqlc_handle_t db, int timeout_ms);
+/* Fill buf with up to len/8 int64 values at the SQLC_BUSY_STAT_* index positions
+ * (lock conflicts, retries, ns spent waiting, conflicts given up with SQLITE_BUSY) & return the number of values.
+ * May be called from any thread. With reset=1 the counters are reset after reading. */
+int sqlc_busy_profile_stats(sqlc_handle_t busy, void *buf, int len, int reset);
+/* Remove the busy handler (no busy timeout) & free it, must be called before sqlc_db_close(): */
+int sqlc_busy_profile_stop(sqlc_handle_t busy);
+
+/* Fill buf with up to len/8 int64 (native byte order) values at the SQLC_STAT_* index positions,
+ * returns the number of values. With reset=1 the counters & high-water marks are reset after reading. */
+int sqlc_db_stats(sqlc_handle_t db, void *buf, int len, int reset);
+
+/* Run a query & write the rows straight to a file (created or truncated) through a fixed-size buffer,
+ * as SQLC_EXPORT_NDJSON (one JSON object per row) or SQLC_EXPORT_CSV (RFC 4180 with a header line).
+ * params is a JSON array of string/number/true/false/null values (NULL for none).
+ * Fills stats with up to len/8 int64 values at the SQLC_EXPORT_STAT_* index positions
+ * & returns SQLC_RESULT_OK or an error code (the file may be incomplete in case of an error). */
+int sqlc_db_export(sqlc_handle_t db, const char *sql, const char *params, const char *path, int format, void *stats, int len);
+
+/* Read rows from a file in the same formats & bind each to one prepared statement (such as INSERT).
+ * NDJSON lines may be arrays (bound in order) or objects (bound by :name, @name or $name,
+ * in order if the statement has positional parameters). CSV fields are bound as text
+ * in order after the header line, an empty unquoted field is bound as NULL.
+ * Rows are inserted in transactions of chunk_rows rows (0 for SQLC_IMPORT_DEFAULT_CHUNK),
+ * unless a transaction is already open.
+ * A row that fails with a constraint, type or size error is skipped & counted.
+ * Fills stats (up to len/8 int64 values, at least SQLC_IMPORT_STAT_COUNT) with the SQLC_IMPORT_STAT_* values
+ * followed by the row numbers (1-based) of the failed rows. Returns SQLC_RESULT_OK or an error code
+ * (any other error stops the import & rolls back the rows since the last completed chunk). */
+int sqlc_db_import(sqlc_handle_t db, const char *path, int format, const char *sql, int chunk_rows, void *stats, int len);
+
+/* Read the pages of the given tables & indexes (comma-separated names in the main database,
+ * NULL for all) into the page cache, up to about max_bytes (0 for no limit), for example from a
+ * background thread right after opening (partial indexes are skipped). For the whole database the OS is also asked to read ahead
+ * (posix_fadvise() where available). The page cache (PRAGMA cache_size) should be large enough to keep them.
+ * Fills stats with up to len/8 int64 values at the SQLC_WARMUP_STAT_* index positions (pages read into
+ * the cache, bytes, elapsed ms) & returns SQLC_RESULT_OK, SQLC_RESULT_NOTFOUND if a name was not found
+ * (the others are still read) or another error code. */
+int sqlc_db_warmup(sqlc_handle_t db, const char *names, sqlc_long_t max_bytes, void *stats, int len);
+
+/* Replace a database of the connection (schema NULL for "main") with an in-memory copy of
+ * size bytes of a database image from a direct buffer (sqlite3_deserialize()).
+ * With SQLC_DESERIALIZE_READONLY the buffer is used in place (zero-copy, read-only) & must stay valid
+ * until the connection is closed or the database is replaced. */
+int sqlc_db_deserialize(sqlc_handle_t db, const char *schema, void *buf, sqlc_long_t size, int flags);
+/* Same with a database image read from size bytes at offset in a file (size 0 for the rest of the file),
+ * read-only with SQLC_DESERIALIZE_READONLY. */
+int sqlc_db_deserialize_file(sqlc_handle_t db, const char *schema, const char *path, sqlc_long_t offset, sqlc_long_t size, int flags);
+/* Copy a database (schema NULL for "main") to a direct buffer of len bytes if it fits,
+ * returns the database size in bytes (negative number indicates an error). */
+sqlc_long_t sqlc_db_serialize(sqlc_handle_t db, const char *schema, void *buf, sqlc_long_t len);
+
+/* Register native SQL functions on the connection (mask of SQLC_FUNC_* groups):
+ *   SQLC_FUNC_REGEXP: text REGEXP pattern (POSIX extended regular expression)
+ *   SQLC_FUNC_HASH:   fnv1a64(x) 64-bit FNV-1a hash of the text/blob bytes,
+ *                     fingerprint(x, ...) order-independent aggregate hash of the rows
+ *   SQLC_FUNC_GEO:    haversine(lat1, lon1, lat2, lon2) distance in meters */
+int sqlc_db_register_functions(sqlc_handle_t db, int mask);
+
+/* Process-wide heap limits in bytes (sqlite3_soft_heap_limit64() & sqlite3_hard_heap_limit64(), 0 for no limit),
+ * returns the previous limit (n negative to only query the limit): */
+sqlc_long_t sqlc_soft_heap_limit(sqlc_long_t n);
+sqlc_long_t sqlc_hard_heap_limit(sqlc_long_t n);
+
+/* Free memory that is not in use by one connection (page cache, sqlite3_db_release_memory()) & by its
+ * fj handles (token buffers kept from the last run & cached results; the last sqlc_fj_run() result stays valid
+ * & is freed by the next run or dispose).
+ * Call from the thread that uses the connection. Returns the number of bytes freed (negative number indicates an error). */
+sqlc_long_t sqlc_db_release_memory(sqlc_handle_t db);
+/* Free the memory kept by all fj handles that are not running (as above) & call sqlite3_release_memory(),
+ * may be called from any thread (such as on Android onTrimMemory()). Returns the number of bytes freed. */
+sqlc_long_t sqlc_release_memory(void);
+/* Fill buf with up to len/8 int64 values at the SQLC_MEM_STAT_* index positions
+ * (SQLite memory in use & high-water mark, heap limits, bytes kept by fj handles) & return the number of values. */
+int sqlc_memory_stats(void *buf, int len);
+
+/* Maintenance in up to about budget_ms milliseconds, for a background scheduler. In this order (flags):
+ *   SQLC_MAINTAIN_CHECKPOINT: passive WAL checkpoint,
+ *   SQLC_MAINTAIN_CHECKPOINT_RESTART: then restart the WAL if all frames were checkpointed
+ *     (may wait for readers in the busy handler),
+ *   SQLC_MAINTAIN_VACUUM: PRAGMA incremental_vacuum in steps of 128 pages
+ *     (if PRAGMA auto_vacuum=INCREMENTAL),
+ *   SQLC_MAINTAIN_OPTIMIZE: PRAGMA optimize.
+ * A step still running when the budget runs out is interrupted (& rolled back).
+ * Fills stats with up to len/8 int64 values at the SQLC_MAINTAIN_STAT_* index positions
+ * (WAL frames & frames checkpointed (-1 if not in WAL mode), free pages released & left, elapsed ms)
+ * & returns SQLC_RESULT_OK if done, SQLC_RESULT_INTERRUPT if the budget ran out or another error code. */
+int sqlc_db_maintain(sqlc_handle_t db, int budget_ms, int flags, void *stats, int len);
+
+/* Process-wide directory for temporary files (sqlite3_temp_directory, NULL for the default),
+ * such as the app cache directory on Android where none of the default directories exist.
+ * Call before any connection uses a temp file. */
+int sqlc_temp_directory(const char *dir);
+/* Temp store (SQLC_TEMP_STORE_*) of one connection for the sorts & temp b-trees of large ORDER BY,
+ * GROUP BY, DISTINCT & temp tables. spill_bytes (not changed if <= 0) sets the cache size of the main
+ * & temp databases (PRAGMA cache_size, so it also limits the page cache of main): with SQLC_TEMP_STORE_FILE
+ * a sort (ORDER BY, GROUP BY & CREATE INDEX without a usable index) & the tables of the temp database
+ * keep up to about spill_bytes in memory & spill the rest to temp files. The ephemeral b-trees of DISTINCT,
+ * UNION, IN (...) & materialized views are not limited by it: they spill above the compile-time
+ * SQLITE_DEFAULT_CACHE_SIZE (about 2 MB). Cannot be changed within a transaction. */
+int sqlc_db_temp_store(sqlc_handle_t db, int mode, sqlc_long_t spill_bytes);
+
+/* Session extension (built with -DSQLITE_ENABLE_SESSION -DSQLITE_ENABLE_PREUPDATE_HOOK, else SQLC_RESULT_ERROR):
+ * record the changes to the attached tables of one schema (NULL for "main") of a connection. */
+sqlc_handle_t sqlc_db_session_new(sqlc_handle_t db, const char *schema);
+/* Record the changes to one table (NULL for all tables), tables without a PRIMARY KEY are ignored: */
+int sqlc_session_attach(sqlc_handle_t session, const char *table);
+/* Stop (0) or restart (1) recording, such as while applying a changeset from the server,
+ * returns the new state (-1 to only query the state): */
+int sqlc_session_enable(sqlc_handle_t session, int enable);
+/* Write the changeset (or patchset with patchset=1) of the changes recorded so far to a direct buffer
+ * & return its size in bytes (negative number indicates an error).
+ * If the size is greater than len the buffer holds an incomplete prefix: call again with a larger buffer. */
+int sqlc_session_changeset(sqlc_handle_t session, int patchset, void *buf, int len);
+/* Delete the session, must be called before sqlc_db_close() of its db: */
+int sqlc_session_delete(sqlc_handle_t session);
+/* Apply a changeset (or patchset) of len bytes from a direct buffer in one transaction.
+ * Conflicts with the changes of type DATA or CONFLICT are resolved by policy (SQLC_CHANGESET_*);
+ * the other conflicts are omitted unless policy is SQLC_CHANGESET_ABORT.
+ * Fills stats with up to slen/8 int64 counts of each type of conflict at the SQLC_CHANGESET_STAT_* index positions
+ * & returns SQLC_RESULT_OK, SQLC_RESULT_ABORT if aborted by policy (nothing applied) or another error code. */
+int sqlc_db_changeset_apply(sqlc_handle_t db, const void *buf, int len, int policy, void *stats, int slen);
+
 int sqlc_db_close(sqlc_handle_t db);
 
+/* Interrupt any statement running on the db handle, may be called from any thread
+ * (calls sqlite3_interrupt()) */
+void sqlc_db_interrupt(sqlc_handle_t db);
+
 sqlc_handle_t sqlc_db_new_fj(sqlc_handle_t db);
 
+/* Prepare SQL once and get a small integer ID (> 0) that a batch may use in place of the SQL string
+ * (negative number indicates an error). Registered statements are finalized by sqlc_fj_dispose(),
+ * which must be called before sqlc_db_close(). */
+int sqlc_fj_register_sql(sqlc_handle_t fj, const char *sql);
+
+/* Limit each sqlc_fj_run() by time in milliseconds and/or number of VM steps (0 for no limit).
+ * If the budget runs out or the db is interrupted, the result has the rows & results
+ * produced so far followed by "interrupted" and the index of the first statement
+ * that was not completed (to resume from). */
+int sqlc_fj_set_budget(sqlc_handle_t fj, int ms, sqlc_long_t vm_steps);
+
+/* Opt-in cache of read-only query results, keyed by SQL & parameters, up to max_bytes (0 to disable).
+ * The cache is dropped whenever the main database may have changed (checked with
+ * PRAGMA data_version/schema_version & sqlite3_total_changes() at the start of each run).
+ * NOTE: do not enable for queries with non-deterministic results such as random() or date('now'). */
+int sqlc_fj_set_cache(sqlc_handle_t fj, int max_bytes);
+
+/* Optional pipelined mode (enable=1): for a large result, one thread steps the statement while
+ * a second thread encodes the rows (same output as the normal mode). */
+void sqlc_fj_set_pipeline(sqlc_handle_t fj, int enable);
+
+/* Fill buf with up to len/8 int64 (native byte order) values at the SQLC_FJ_STAT_* index positions,
+ * returns the number of values (0 unless built with -DSQLC_FJ_STATS). */
+int sqlc_fj_alloc_stats(sqlc_handle_t fj, void *buf, int len);
+
 const char *sqlc_fj_run(sqlc_handle_t fj, const char *batch_json, int ll);
 
 void sqlc_fj_dispose(sqlc_handle_t fj);
+
+/* Run batches on several databases in parallel on up to max_threads threads (including the calling thread).
+ * Add (fj handle, batch) pairs with sqlc_multi_add() (returns the index of the pair or a negative error),
+ * each fj handle at most once. Batches on the same database run one after another in the order added.
+ * sqlc_multi_run() runs all pairs added since the last run & returns all results in order as a JSON array
+ * of sqlc_fj_run() results (valid until the next run, sqlc_fj_run() on one of the fj handles or dispose). */
+sqlc_handle_t sqlc_multi_new(int max_threads);
+int sqlc_multi_add(sqlc_handle_t multi, sqlc_handle_t fj, const char *batch_json, int ll);
+const char *sqlc_multi_run(sqlc_handle_t multi);
+void sqlc_multi_dispose(sqlc_handle_t multi);
@@ -5,6 +5,8 @@
 
 #include "SQLiteNative_JNI.c"
 
+#include "sqlc_jni_onload.c"
+
 #include "jsmn.c"
 
 #include "sqlc.c"
@@ -0,0 +1,124 @@
+/* Explicit registration of the native methods (from SQLiteNative_JNI.c) when the library is loaded,
+ * instead of a symbol lookup by name for each method on its first call
+ * (left out if built with -DSQLC_JNI_NO_REGISTER, to compare in bench/SQLiteNativeBench.java).
+ * NOTE: keep this table in sync with the native methods of io.liteglue.SQLiteNative */
+
+#ifndef SQLC_JNI_NO_REGISTER
+
+#define SQLC_JNI_CLASS "io/liteglue/SQLiteNative"
+
+static const JNINativeMethod sqlc_jni_methods[] = {
+  { "sqlc_api_db_open", "(ILjava/lang/String;I)J", (void *)Java_io_liteglue_SQLiteNative_sqlc_1api_1db_1open__ILjava_lang_String_2I },
+  { "sqlc_api_version_check", "(I)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1api_1version_1check__I },
+  { "sqlc_backup_finish", "(J)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1backup_1finish__J },
+  { "sqlc_backup_init", "(JLjava/lang/String;JLjava/lang/String;)J", (void *)Java_io_liteglue_SQLiteNative_sqlc_1backup_1init__JLjava_lang_String_2JLjava_lang_String_2 },
+  { "sqlc_backup_pagecount", "(J)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1backup_1pagecount__J },
+  { "sqlc_backup_remaining", "(J)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1backup_1remaining__J },
+  { "sqlc_backup_step", "(JI)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1backup_1step__JI },
+  { "sqlc_blob_bytes", "(J)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1blob_1bytes__J },
+  { "sqlc_blob_close", "(J)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1blob_1close__J },
+  { "sqlc_blob_open", "(JLjava/lang/String;Ljava/lang/String;Ljava/lang/String;JI)J", (void *)Java_io_liteglue_SQLiteNative_sqlc_1blob_1open__JLjava_lang_String_2Ljava_lang_String_2Ljava_lang_String_2JI },
+  { "sqlc_blob_read0", "(JLjava/lang/Object;III)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1blob_1read0__JLjava_lang_Object_2III },
+  { "sqlc_blob_reopen", "(JJ)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1blob_1reopen__JJ },
+  { "sqlc_blob_write0", "(JLjava/lang/Object;III)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1blob_1write0__JLjava_lang_Object_2III },
+  { "sqlc_busy_profile_stats0", "(JLjava/lang/Object;III)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1busy_1profile_1stats0__JLjava_lang_Object_2III },
+  { "sqlc_busy_profile_stop", "(J)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1busy_1profile_1stop__J },
+  { "sqlc_changes_drain0", "(JLjava/lang/Object;II)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1changes_1drain0__JLjava_lang_Object_2II },
+  { "sqlc_changes_dropped", "(J)J", (void *)Java_io_liteglue_SQLiteNative_sqlc_1changes_1dropped__J },
+  { "sqlc_changes_stop", "(J)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1changes_1stop__J },
+  { "sqlc_changes_table_name", "(JI)Ljava/lang/String;", (void *)Java_io_liteglue_SQLiteNative_sqlc_1changes_1table_1name__JI },
+  { "sqlc_db_busy_profile_start", "(JI)J", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1busy_1profile_1start__JI },
+  { "sqlc_db_changes_start", "(JI)J", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1changes_1start__JI },
+  { "sqlc_db_changeset_apply0", "(JLjava/lang/Object;IIILjava/lang/Object;II)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1changeset_1apply0__JLjava_lang_Object_2IIILjava_lang_Object_2II },
+  { "sqlc_db_close", "(J)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1close__J },
+  { "sqlc_db_deserialize0", "(JLjava/lang/String;Ljava/lang/Object;IJI)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1deserialize0__JLjava_lang_String_2Ljava_lang_Object_2IJI },
+  { "sqlc_db_deserialize_file", "(JLjava/lang/String;Ljava/lang/String;JJI)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1deserialize_1file__JLjava_lang_String_2Ljava_lang_String_2JJI },
+  { "sqlc_db_errcode", "(J)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1errcode__J },
+  { "sqlc_db_errmsg_native", "(J)Ljava/lang/String;", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1errmsg_1native__J },
+  { "sqlc_db_export0", "(JLjava/lang/String;Ljava/lang/String;Ljava/lang/String;ILjava/lang/Object;II)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1export0__JLjava_lang_String_2Ljava_lang_String_2Ljava_lang_String_2ILjava_lang_Object_2II },
+  { "sqlc_db_import0", "(JLjava/lang/String;ILjava/lang/String;ILjava/lang/Object;II)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1import0__JLjava_lang_String_2ILjava_lang_String_2ILjava_lang_Object_2II },
+  { "sqlc_db_interrupt", "(J)V", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1interrupt__J },
+  { "sqlc_db_key_native_string", "(JLjava/lang/String;)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1key_1native_1string__JLjava_lang_String_2 },
+  { "sqlc_db_last_insert_rowid", "(J)J", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1last_1insert_1rowid__J },
+  { "sqlc_db_maintain0", "(JIILjava/lang/Object;II)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1maintain0__JIILjava_lang_Object_2II },
+  { "sqlc_db_new_fj", "(J)J", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1new_1fj__J },
+  { "sqlc_db_open", "(Ljava/lang/String;I)J", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1open__Ljava_lang_String_2I },
+  { "sqlc_db_open_vfs", "(Ljava/lang/String;ILjava/lang/String;)J", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1open_1vfs__Ljava_lang_String_2ILjava_lang_String_2 },
+  { "sqlc_db_prepare_st", "(JLjava/lang/String;)J", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1prepare_1st__JLjava_lang_String_2 },
+  { "sqlc_db_register_functions", "(JI)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1register_1functions__JI },
+  { "sqlc_db_release_memory", "(J)J", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1release_1memory__J },
+  { "sqlc_db_serialize0", "(JLjava/lang/String;Ljava/lang/Object;IJ)J", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1serialize0__JLjava_lang_String_2Ljava_lang_Object_2IJ },
+  { "sqlc_db_session_new", "(JLjava/lang/String;)J", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1session_1new__JLjava_lang_String_2 },
+  { "sqlc_db_stats0", "(JLjava/lang/Object;III)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1stats0__JLjava_lang_Object_2III },
+  { "sqlc_db_temp_store", "(JIJ)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1temp_1store__JIJ },
+  { "sqlc_db_total_changes", "(J)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1total_1changes__J },
+  { "sqlc_db_total_changes64", "(J)J", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1total_1changes64__J },
+  { "sqlc_db_trace_start", "(JII)J", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1trace_1start__JII },
+  { "sqlc_db_warmup0", "(JLjava/lang/String;JLjava/lang/Object;II)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1db_1warmup0__JLjava_lang_String_2JLjava_lang_Object_2II },
+  { "sqlc_errstr_native", "(I)Ljava/lang/String;", (void *)Java_io_liteglue_SQLiteNative_sqlc_1errstr_1native__I },
+  { "sqlc_fj_alloc_stats0", "(JLjava/lang/Object;II)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1fj_1alloc_1stats0__JLjava_lang_Object_2II },
+  { "sqlc_fj_dispose", "(J)V", (void *)Java_io_liteglue_SQLiteNative_sqlc_1fj_1dispose__J },
+  { "sqlc_fj_register_sql", "(JLjava/lang/String;)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1fj_1register_1sql__JLjava_lang_String_2 },
+  { "sqlc_fj_run", "(JLjava/lang/String;I)Ljava/lang/String;", (void *)Java_io_liteglue_SQLiteNative_sqlc_1fj_1run__JLjava_lang_String_2I },
+  { "sqlc_fj_set_budget", "(JIJ)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1fj_1set_1budget__JIJ },
+  { "sqlc_fj_set_cache", "(JI)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1fj_1set_1cache__JI },
+  { "sqlc_fj_set_pipeline", "(JI)V", (void *)Java_io_liteglue_SQLiteNative_sqlc_1fj_1set_1pipeline__JI },
+  { "sqlc_hard_heap_limit", "(J)J", (void *)Java_io_liteglue_SQLiteNative_sqlc_1hard_1heap_1limit__J },
+  { "sqlc_memory_stats0", "(Ljava/lang/Object;II)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1memory_1stats0__Ljava_lang_Object_2II },
+  { "sqlc_multi_add", "(JJLjava/lang/String;I)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1multi_1add__JJLjava_lang_String_2I },
+  { "sqlc_multi_dispose", "(J)V", (void *)Java_io_liteglue_SQLiteNative_sqlc_1multi_1dispose__J },
+  { "sqlc_multi_new", "(I)J", (void *)Java_io_liteglue_SQLiteNative_sqlc_1multi_1new__I },
+  { "sqlc_multi_run", "(J)Ljava/lang/String;", (void *)Java_io_liteglue_SQLiteNative_sqlc_1multi_1run__J },
+  { "sqlc_range_vfs_register", "()I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1range_1vfs_1register__ },
+  { "sqlc_release_memory", "()J", (void *)Java_io_liteglue_SQLiteNative_sqlc_1release_1memory__ },
+  { "sqlc_session_attach", "(JLjava/lang/String;)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1session_1attach__JLjava_lang_String_2 },
+  { "sqlc_session_changeset0", "(JILjava/lang/Object;II)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1session_1changeset0__JILjava_lang_Object_2II },
+  { "sqlc_session_delete", "(J)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1session_1delete__J },
+  { "sqlc_session_enable", "(JI)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1session_1enable__JI },
+  { "sqlc_soft_heap_limit", "(J)J", (void *)Java_io_liteglue_SQLiteNative_sqlc_1soft_1heap_1limit__J },
+  { "sqlc_st_bind_all0", "(JLjava/lang/Object;II)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1st_1bind_1all0__JLjava_lang_Object_2II },
+  { "sqlc_st_bind_double", "(JID)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1st_1bind_1double__JID },
+  { "sqlc_st_bind_int", "(JII)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1st_1bind_1int__JII },
+  { "sqlc_st_bind_long", "(JIJ)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1st_1bind_1long__JIJ },
+  { "sqlc_st_bind_null", "(JI)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1st_1bind_1null__JI },
+  { "sqlc_st_bind_text_native", "(JILjava/lang/String;)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1st_1bind_1text_1native__JILjava_lang_String_2 },
+  { "sqlc_st_clear_bindings", "(J)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1st_1clear_1bindings__J },
+  { "sqlc_st_column_count", "(J)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1st_1column_1count__J },
+  { "sqlc_st_column_double", "(JI)D", (void *)Java_io_liteglue_SQLiteNative_sqlc_1st_1column_1double__JI },
+  { "sqlc_st_column_int", "(JI)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1st_1column_1int__JI },
+  { "sqlc_st_column_long", "(JI)J", (void *)Java_io_liteglue_SQLiteNative_sqlc_1st_1column_1long__JI },
+  { "sqlc_st_column_name", "(JI)Ljava/lang/String;", (void *)Java_io_liteglue_SQLiteNative_sqlc_1st_1column_1name__JI },
+  { "sqlc_st_column_text_native", "(JI)Ljava/lang/String;", (void *)Java_io_liteglue_SQLiteNative_sqlc_1st_1column_1text_1native__JI },
+  { "sqlc_st_column_type", "(JI)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1st_1column_1type__JI },
+  { "sqlc_st_finish", "(J)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1st_1finish__J },
+  { "sqlc_st_reset", "(J)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1st_1reset__J },
+  { "sqlc_st_step", "(J)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1st_1step__J },
+  { "sqlc_temp_directory", "(Ljava/lang/String;)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1temp_1directory__Ljava_lang_String_2 },
+  { "sqlc_trace_drain0", "(JLjava/lang/Object;II)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1trace_1drain0__JLjava_lang_Object_2II },
+  { "sqlc_trace_dropped", "(J)J", (void *)Java_io_liteglue_SQLiteNative_sqlc_1trace_1dropped__J },
+  { "sqlc_trace_stop", "(J)I", (void *)Java_io_liteglue_SQLiteNative_sqlc_1trace_1stop__J },
+};
+
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void *reserved)
+{
+  JNIEnv *env = NULL;
+  jclass c;
+
+  if ((*vm)->GetEnv(vm, (void **)&env, JNI_VERSION_1_6) != JNI_OK) return JNI_ERR;
+
+  c = (*env)->FindClass(env, SQLC_JNI_CLASS);
+  if (c == NULL) {
+    // (class not loaded by this class loader) fall back to lookup by name
+    (*env)->ExceptionClear(env);
+    return JNI_VERSION_1_6;
+  }
+
+  if ((*env)->RegisterNatives(env, c, sqlc_jni_methods, sizeof(sqlc_jni_methods)/sizeof(sqlc_jni_methods[0])) != JNI_OK) {
+    // (Java class does not match this table) fall back to lookup by name
+    (*env)->ExceptionClear(env);
+  }
+
+  (*env)->DeleteLocalRef(env, c);
+  return JNI_VERSION_1_6;
+}
+#endif
@@ -0,0 +1,104 @@
+/* Host test of the 64-bit sizes in the batch runner (make test):
+ * text parameters bound with sqlite3_bind_text64(), rowids & change counts above 2^31
+ * & (64-bit ABI with enough memory only) a result of more than INT_MAX bytes. */
+
+#include "sqlite3.c"
+
+#include "sqlc.h"
+
+#include "jsmn.c"
+
+#include "sqlc.c"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(x) do { if (!(x)) { fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #x); exit(1); } } while (0)
+
+// rows of LARGE_ROW_BYTES in the result of more than INT_MAX bytes:
+#define LARGE_ROW_BYTES 200000000
+#define LARGE_ROWS 11
+
+static void test_bind_text64(sqlc_handle_t fj)
+{
+  const size_t n = 100000000;
+  const char * pre = "[1,1,\"SELECT length(?1), substr(?1, -3)\",1,\"";
+  char * batch = malloc(strlen(pre) + n + 10);
+  const char * r;
+
+  CHECK(batch != NULL);
+  strcpy(batch, pre);
+  memset(batch + strlen(pre), 'x', n);
+  strcpy(batch + strlen(pre) + n - 3, "xyz\"]");
+
+  r = sqlc_fj_run(fj, batch, 100);
+  CHECK(strstr(r, "\"length(?1)\",100000000,\"substr(?1, -3)\",\"xyz\"") != NULL);
+  free(batch);
+}
+
+static void test_rowid64(sqlc_handle_t fj)
+{
+  const char * r = sqlc_fj_run(fj,
+    "[1,2,\"CREATE TABLE r(x)\",0,\"INSERT INTO r(rowid, x) VALUES (5000000000, 1)\",0]", 100);
+
+  CHECK(strstr(r, ",5000000000,") != NULL);
+}
+
+static void test_result_above_int_max(sqlc_handle_t fj)
+{
+  char batch[300];
+  const char * r, * p;
+  size_t rl, i;
+
+  snprintf(batch, sizeof batch,
+    "[1,1,\"WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x+1 FROM c LIMIT %d) "
+    "SELECT x, printf('%%.*c', %d, 'a') AS a FROM c\",0]", LARGE_ROWS, LARGE_ROW_BYTES);
+
+  r = sqlc_fj_run(fj, batch, 100);
+  rl = strlen(r);
+  printf("result: %zu bytes\n", rl);
+  CHECK(rl > (size_t)INT_MAX);
+  CHECK(strstr(r + rl - 30, "\"endrows\"") != NULL);
+
+  // each row: ...,"x",i,"a","aaa...aaa",
+  for (p = r, i = 0; i < LARGE_ROWS; ++i) {
+    char key[40];
+
+    snprintf(key, sizeof key, "\"x\",%zu,", i + 1);
+    p = strstr(p, key);
+    CHECK(p != NULL);
+    p = strstr(p, "\"a\",\"");
+    CHECK(p != NULL);
+    p += 5;
+    CHECK(p[0] == 'a' && p[LARGE_ROW_BYTES - 1] == 'a' && p[LARGE_ROW_BYTES] == '\"');
+  }
+}
+
+int main(void)
+{
+  sqlc_handle_t db = sqlc_db_open(":memory:", SQLC_OPEN_READWRITE | SQLC_OPEN_CREATE);
+  sqlc_handle_t fj;
+  long pages = sysconf(_SC_PHYS_PAGES);
+  long psize = sysconf(_SC_PAGESIZE);
+
+  CHECK(db > 0);
+  fj = sqlc_db_new_fj(db);
+  CHECK(fj > 0);
+
+  test_bind_text64(fj);
+  test_rowid64(fj);
+  CHECK(sqlc_db_total_changes64(db) == 1);
+
+  // result buffer growth copies the old buffer: about 2x the result at the peak
+  if (sizeof(size_t) < 8 || pages < 0 || (double)pages * psize < 5e9) {
+    printf("SKIP result above INT_MAX (needs a 64-bit ABI & 5 GB of memory)\n");
+  } else {
+    test_result_above_int_max(fj);
+  }
+
+  sqlc_fj_dispose(fj);
+  sqlc_db_close(db);
+  printf("ok\n");
+  return 0;
+}
@@ -0,0 +1,153 @@
+/* Host test of the read-only file-range VFS (make test):
+ * a database stored at an unaligned offset of a larger file, read with & without memory-mapped I/O,
+ * writes rejected with SQLITE_READONLY & bad offset/length values. */
+
+#include "sqlite3.c"
+
+#include "sqlc.h"
+
+#include "jsmn.c"
+
+#include "sqlc.c"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(x) do { if (!(x)) { fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #x); exit(1); } } while (0)
+
+#define DB_PATH "/tmp/sqlc_test_range.db"
+#define PACK_PATH "/tmp/sqlc_test_range.pack"
+
+// not a multiple of the OS page size:
+#define PACK_OFFSET 12345
+
+static sqlite3 * db_of(sqlc_handle_t db)
+{
+  return HANDLE_TO_VP(db);
+}
+
+static sqlc_long_t query_long(sqlc_handle_t db, const char * sql)
+{
+  sqlc_handle_t st = sqlc_db_prepare_st(db, sql);
+  sqlc_long_t v;
+
+  CHECK(st > 0);
+  CHECK(sqlc_st_step(st) == SQLC_RESULT_ROW);
+  v = sqlc_st_column_long(st, 0);
+  sqlc_st_finish(st);
+  return v;
+}
+
+// database file with some pages of data, stored at PACK_OFFSET of PACK_PATH with junk around it:
+static long make_pack(void)
+{
+  sqlc_handle_t db;
+  FILE * in, * out;
+  char * buf;
+  long size, i;
+
+  unlink(DB_PATH);
+  db = sqlc_db_open(DB_PATH, SQLC_OPEN_READWRITE | SQLC_OPEN_CREATE);
+  CHECK(db > 0);
+  CHECK(sqlite3_exec(db_of(db), "PRAGMA page_size=1024; CREATE TABLE t(a INTEGER PRIMARY KEY, b TEXT);"
+    "WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x+1 FROM c LIMIT 2000)"
+    " INSERT INTO t SELECT x, printf('row %d', x) FROM c", NULL, NULL, NULL) == SQLITE_OK);
+  CHECK(sqlc_db_close(db) == SQLITE_OK);
+
+  in = fopen(DB_PATH, "rb");
+  CHECK(in != NULL);
+  fseek(in, 0, SEEK_END);
+  size = ftell(in);
+  rewind(in);
+  buf = malloc(size);
+  CHECK(buf != NULL && fread(buf, 1, size, in) == (size_t)size);
+  fclose(in);
+
+  out = fopen(PACK_PATH, "wb");
+  CHECK(out != NULL);
+  for (i = 0; i < PACK_OFFSET; ++i) fputc('x', out);
+  CHECK(fwrite(buf, 1, size, out) == (size_t)size);
+  for (i = 0; i < 999; ++i) fputc('y', out);
+  fclose(out);
+
+  free(buf);
+  return size;
+}
+
+static sqlc_handle_t open_range(long offset, long length, int flags)
+{
+  char uri[200];
+
+  snprintf(uri, sizeof uri, "file:" PACK_PATH "?offset=%ld&length=%ld", offset, length);
+  return sqlc_db_open_vfs(uri, flags | SQLC_OPEN_URI, SQLC_RANGE_VFS);
+}
+
+static void test_read(long size, int mmap)
+{
+  sqlc_handle_t db = open_range(PACK_OFFSET, size, SQLC_OPEN_READONLY);
+
+  CHECK(db > 0);
+  CHECK(sqlite3_exec(db_of(db), mmap ? "PRAGMA mmap_size=268435456" : "PRAGMA mmap_size=0",
+    NULL, NULL, NULL) == SQLITE_OK);
+  CHECK(query_long(db, "SELECT count(*) FROM t") == 2000);
+  CHECK(query_long(db, "SELECT sum(a) FROM t WHERE b LIKE 'row %'") == 2001000);
+  CHECK(query_long(db, "SELECT count(*) FROM pragma_integrity_check WHERE integrity_check = 'ok'") == 1);
+  CHECK(sqlc_db_close(db) == SQLITE_OK);
+}
+
+static void test_readonly(long size)
+{
+  sqlc_handle_t db = open_range(PACK_OFFSET, size, SQLC_OPEN_READONLY);
+  int rv;
+
+  CHECK(db > 0);
+  rv = sqlite3_exec(db_of(db), "INSERT INTO t(b) VALUES ('new')", NULL, NULL, NULL);
+  CHECK((rv & 0xff) == SQLITE_READONLY);
+  CHECK(query_long(db, "SELECT count(*) FROM t") == 2000);
+  CHECK(sqlc_db_close(db) == SQLITE_OK);
+
+  // opened read/write, the main database is still read-only:
+  db = open_range(PACK_OFFSET, size, SQLC_OPEN_READWRITE);
+  if (db > 0) {
+    rv = sqlite3_exec(db_of(db), "INSERT INTO t(b) VALUES ('new')", NULL, NULL, NULL);
+    CHECK((rv & 0xff) == SQLITE_READONLY);
+    CHECK(sqlc_db_close(db) == SQLITE_OK);
+  }
+}
+
+static void test_bad_range(long size)
+{
+  sqlc_handle_t db;
+
+  // whole database at a wrong offset: not a database
+  db = open_range(PACK_OFFSET + 1, size, SQLC_OPEN_READONLY);
+  if (db > 0) {
+    CHECK((sqlite3_exec(db_of(db), "SELECT count(*) FROM t", NULL, NULL, NULL) & 0xff) == SQLITE_NOTADB);
+    sqlc_db_close(db);
+  }
+
+  // beyond the end of the file:
+  CHECK(open_range(PACK_OFFSET, size + 1000, SQLC_OPEN_READONLY) == -SQLITE_CANTOPEN);
+  CHECK(open_range(PACK_OFFSET + size + 1000, 0, SQLC_OPEN_READONLY) == -SQLITE_CANTOPEN);
+  CHECK(open_range(-1, size, SQLC_OPEN_READONLY) == -SQLITE_CANTOPEN);
+  CHECK(open_range(PACK_OFFSET, -1, SQLC_OPEN_READONLY) == -SQLITE_CANTOPEN);
+}
+
+int main(void)
+{
+  long size;
+
+  CHECK(sqlc_range_vfs_register() == SQLITE_OK);
+  size = make_pack();
+
+  test_read(size, 0);
+  test_read(size, 1);
+  test_readonly(size);
+  test_bad_range(size);
+
+  unlink(DB_PATH);
+  unlink(PACK_PATH);
+  printf("ok\n");
+  return 0;
+}